@@ -0,0 +1,144 @@
+//dael12345@gmail.com
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+namespace dael_containers {
+
+    /**
+     * @class Generator
+     * @brief Minimal C++20 coroutine generator: a move-only input view whose
+     *        elements are produced by co_yield, one per resumption.
+     *
+     * Elements are yielded by reference and must stay alive until the coroutine
+     * is resumed again (elements of a container, or temporaries in the co_yield
+     * expression, both do). An exception escaping the coroutine is rethrown from
+     * the begin() or operator++ call that resumed it.
+     *
+     * @tparam T The element type; the generator yields const T&.
+     */
+    template<typename T>
+    class Generator : public std::ranges::view_base {
+    public:
+        struct promise_type {
+            const T* current = nullptr;
+            std::exception_ptr error;
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always yield_value(const T& value) noexcept {
+                current = std::addressof(value);
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() {
+                error = std::current_exception();
+            }
+
+            // Generators only yield; awaiting inside one is not supported
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        class iterator {
+        private:
+            Handle coroutine = nullptr;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(Handle handle) : coroutine(handle) {}
+
+            // Dereferencing to get current value
+            const T& operator*() const {
+                return *coroutine.promise().current;
+            }
+
+            // Prefix increment to advance iterator
+            iterator& operator++() {
+                resume(coroutine);
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) {
+                return !it.coroutine || it.coroutine.done();
+            }
+        };
+
+        Generator() = default;
+
+        Generator(Generator&& other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (coroutine) {
+                    coroutine.destroy();
+                }
+                coroutine = std::exchange(other.coroutine, nullptr);
+            }
+            return *this;
+        }
+
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        ~Generator() {
+            if (coroutine) {
+                coroutine.destroy();
+            }
+        }
+
+        /**
+         * @brief Runs the coroutine up to its first co_yield. Call once per generator.
+         */
+        iterator begin() {
+            resume(coroutine);
+            return iterator(coroutine);
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+        Handle coroutine = nullptr;
+
+        explicit Generator(Handle handle) : coroutine(handle) {}
+
+        static void resume(Handle handle) {
+            if (handle && !handle.done()) {
+                handle.resume();
+                if (handle.promise().error) {
+                    std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+                }
+            }
+        }
+    };
+
+}
@@ -0,0 +1,259 @@
+//dael12345@gmail.com
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace dael_containers {
+
+/**
+ * @brief Chooses how the value-ordered iterators obtain their order.
+ *
+ * Snapshot builds (or reuses) the container's fully sorted view.
+ * Lazy produces elements on demand, so reading only the first k elements
+ * costs O(n + k log n) instead of a full sort.
+ */
+enum class TraversalMode {
+    Snapshot,
+    Lazy
+};
+
+namespace detail {
+
+    /**
+     * @class LazySortedIndex
+     * @brief Produces the indices of a vector in sorted order, one at a time.
+     *
+     * Heapifies all indices once (O(n)) and pops one per requested element
+     * (O(log n)). Popped indices are remembered, so any number of iterators
+     * sharing the same instance can walk back and forth over what was produced.
+     *
+     * @tparam T The element type of the vector being ordered.
+     */
+    template<typename T>
+    class LazySortedIndex {
+    private:
+        const std::vector<T>& data;
+        bool descending;                 // Produce largest first instead of smallest first
+        std::vector<size_t> heap;        // Indices not produced yet
+        std::vector<size_t> produced;    // Indices already produced, in traversal order
+
+        // Heap comparator: the element that should come out first is the "largest"
+        bool heapLess(size_t a, size_t b) const {
+            return descending ? data[a] < data[b] : data[b] < data[a];
+        }
+
+    public:
+        LazySortedIndex(const std::vector<T>& values, bool largestFirst)
+            : data(values), descending(largestFirst), heap(values.size())
+        {
+            std::iota(heap.begin(), heap.end(), size_t{0});
+            std::make_heap(heap.begin(), heap.end(), [this](size_t a, size_t b) { return heapLess(a, b); });
+        }
+
+        /**
+         * @brief Makes sure at least count indices (or all of them) have been produced.
+         */
+        void ensure(size_t count) {
+            auto cmp = [this](size_t a, size_t b) { return heapLess(a, b); };
+            while (produced.size() < count && !heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), cmp);
+                produced.push_back(heap.back());
+                heap.pop_back();
+            }
+        }
+
+        /**
+         * @brief Returns the index of the element at position pos of the traversal.
+         * @throws std::out_of_range If pos is past the last element.
+         */
+        size_t at(size_t pos) {
+            ensure(pos + 1);
+            if (pos >= produced.size()) {
+                throw std::out_of_range("Iterator out of bounds");
+            }
+            return produced[pos];
+        }
+    };
+
+    /**
+     * @brief Partially orders [base + begin, base + end) so that every position in
+     *        [firstRank, lastRank) holds the element a full sort would put there.
+     *
+     * Ranks must be sorted, unique and absolute (relative to base). Each level
+     * runs one introselect (std::nth_element) on the middle requested rank and
+     * recurses into the two sides with the ranks that fall there, so r ranks
+     * share the partitioning work: expected O(n log r) instead of r times O(n).
+     */
+    template<typename Iterator, typename Compare>
+    void multiSelect(Iterator base, size_t begin, size_t end, const size_t* firstRank, const size_t* lastRank, Compare cmp) {
+        while (firstRank != lastRank) {
+            const size_t* middle = firstRank + (lastRank - firstRank) / 2;
+            std::nth_element(base + static_cast<std::ptrdiff_t>(begin), base + static_cast<std::ptrdiff_t>(*middle),
+                             base + static_cast<std::ptrdiff_t>(end), cmp);
+            multiSelect(base, begin, *middle, firstRank, middle, cmp);
+            // Loop on the right side instead of recursing
+            begin = *middle + 1;
+            firstRank = middle + 1;
+        }
+    }
+
+    /**
+     * @class MinMaxHeap
+     * @brief Double-ended priority queue of indices (Atkinson et al. min-max heap).
+     *
+     * Even levels of the tree are ordered by minimum, odd levels by maximum, so
+     * both the smallest and the largest element can be removed in O(log n).
+     * Building the heap from n indices is O(n).
+     *
+     * @tparam Less Strict weak ordering on indices.
+     */
+    template<typename Less>
+    class MinMaxHeap {
+    private:
+        std::vector<size_t> heap;
+        Less less;
+
+        static bool isMinLevel(size_t i) {
+            size_t depth = 0;
+            for (++i; i > 1; i >>= 1) {
+                ++depth;
+            }
+            return depth % 2 == 0;
+        }
+
+        // True if a should be closer to the root than b on a level of the given kind
+        bool before(size_t a, size_t b, bool minLevel) const {
+            return minLevel ? less(heap[a], heap[b]) : less(heap[b], heap[a]);
+        }
+
+        void trickleDown(size_t i) {
+            bool minLevel = isMinLevel(i);
+            size_t n = heap.size();
+            while (2 * i + 1 < n) {
+                // Best element among the (up to) two children and four grandchildren
+                size_t best = 2 * i + 1;
+                if (2 * i + 2 < n && before(2 * i + 2, best, minLevel)) {
+                    best = 2 * i + 2;
+                }
+                for (size_t g = 4 * i + 3; g <= 4 * i + 6 && g < n; ++g) {
+                    if (before(g, best, minLevel)) best = g;
+                }
+
+                if (!before(best, i, minLevel)) {
+                    return;
+                }
+                std::swap(heap[best], heap[i]);
+                if (best <= 2 * i + 2) {
+                    return;  // Children sit on the opposite kind of level, nothing below needs fixing
+                }
+                size_t parent = (best - 1) / 2;
+                if (before(parent, best, minLevel)) {
+                    std::swap(heap[best], heap[parent]);
+                }
+                i = best;
+            }
+        }
+
+        void removeAt(size_t pos) {
+            heap[pos] = heap.back();
+            heap.pop_back();
+            if (pos < heap.size()) {
+                trickleDown(pos);
+            }
+        }
+
+    public:
+        MinMaxHeap(std::vector<size_t> indices, Less cmp)
+            : heap(std::move(indices)), less(cmp)
+        {
+            for (size_t i = heap.size() / 2; i-- > 0;) {
+                trickleDown(i);
+            }
+        }
+
+        bool empty() const {
+            return heap.empty();
+        }
+
+        size_t popMin() {
+            size_t result = heap[0];
+            removeAt(0);
+            return result;
+        }
+
+        size_t popMax() {
+            size_t pos = 0;
+            if (heap.size() == 2) {
+                pos = 1;
+            } else if (heap.size() > 2) {
+                pos = less(heap[1], heap[2]) ? 2 : 1;
+            }
+            size_t result = heap[pos];
+            removeAt(pos);
+            return result;
+        }
+    };
+
+    /**
+     * @class LazySideCrossIndex
+     * @brief Produces the indices of a vector in side-cross order (smallest, largest,
+     *        next smallest, ...) one at a time, on top of a MinMaxHeap.
+     *
+     * The first k elements cost O(n + k log n) instead of a full sort.
+     * Produced indices are remembered, so iterators sharing the instance can revisit them.
+     *
+     * @tparam T The element type of the vector being ordered.
+     */
+    template<typename T>
+    class LazySideCrossIndex {
+    private:
+        struct IndexLess {
+            const std::vector<T>* data;
+            bool operator()(size_t a, size_t b) const {
+                return (*data)[a] < (*data)[b];
+            }
+        };
+
+        MinMaxHeap<IndexLess> heap;
+        std::vector<size_t> produced;    // Indices already produced, in traversal order
+
+        static std::vector<size_t> allIndices(size_t n) {
+            std::vector<size_t> indices(n);
+            std::iota(indices.begin(), indices.end(), size_t{0});
+            return indices;
+        }
+
+    public:
+        explicit LazySideCrossIndex(const std::vector<T>& values)
+            : heap(allIndices(values.size()), IndexLess{&values})
+        {
+        }
+
+        /**
+         * @brief Makes sure at least count indices (or all of them) have been produced.
+         */
+        void ensure(size_t count) {
+            while (produced.size() < count && !heap.empty()) {
+                // Even steps take the smallest remaining element, odd steps the largest
+                produced.push_back(produced.size() % 2 == 0 ? heap.popMin() : heap.popMax());
+            }
+        }
+
+        /**
+         * @brief Returns the index of the element at position pos of the traversal.
+         * @throws std::out_of_range If pos is past the last element.
+         */
+        size_t at(size_t pos) {
+            ensure(pos + 1);
+            if (pos >= produced.size()) {
+                throw std::out_of_range("Iterator out of bounds");
+            }
+            return produced[pos];
+        }
+    };
+
+}
+
+}
@@ -4,28 +4,494 @@
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <optional>
+#include <cmath>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include "LazySelection.hpp"
+#include "SortKernels.hpp"
+#include "OrderStatisticTree.hpp"
+#include "SearchKernels.hpp"
+#include "RandomAccessFacade.hpp"
+#include "OrderPolicies.hpp"
+#include "ParallelTraversal.hpp"
+#include "Generator.hpp"
 
 namespace dael_containers {
 
+    /**
+     * @brief Storage policy (default): elements are stored in insertion order.
+     *        add() is O(1); the sorted view is built on demand.
+     */
+    struct InsertionOrderStorage {};
+
+    /**
+     * @brief Storage policy: elements are kept sorted at all times.
+     *        add() is a binary-search insert and remove() a binary search plus a
+     *        range erase; Ascending, Descending and SideCross walk the storage
+     *        directly. Each element carries its insertion stamp, and the insertion
+     *        order is rebuilt from the stamps (an O(n) radix sort) when Order,
+     *        ReverseOrder or MiddleOutOrder is walked after a change.
+     */
+    struct SortedStorage {};
+
+    /**
+     * @brief Check policy: dereferencing an iterator out of bounds throws std::out_of_range.
+     */
+    struct BoundsChecked {};
+
+    /**
+     * @brief Check policy: iterators skip the bounds check, so a walk over insertion-ordered
+     *        storage is a plain indexed loop. Dereferencing out of bounds is undefined behavior.
+     */
+    struct Unchecked {};
+
+    /**
+     * @brief BoundsChecked in debug builds, Unchecked when NDEBUG is defined.
+     */
+#ifdef NDEBUG
+    using DefaultCheckPolicy = Unchecked;
+#else
+    using DefaultCheckPolicy = BoundsChecked;
+#endif
+
         /**
      * @class MyContainer
      * @brief A generic container class that stores elements of type T (default: int).
      *        Supports adding, removing elements, and multiple custom iteration orders.
      *
      * @tparam T The type of elements stored in the container. Must be comparable.
+     * @tparam Storage InsertionOrderStorage (default) or SortedStorage.
+     * @tparam CheckPolicy BoundsChecked or Unchecked iterators (default: DefaultCheckPolicy).
      */
-    template<typename T = int>
+    template<typename T = int, typename Storage = InsertionOrderStorage, typename CheckPolicy = DefaultCheckPolicy>
     class MyContainer {
     private:
-        std::vector<T> data;  // Internal storage
+        static constexpr bool keepsSorted = std::is_same<Storage, SortedStorage>::value;
+        static constexpr bool checksBounds = std::is_same<CheckPolicy, BoundsChecked>::value;
+
+        std::vector<T> data;  // Internal storage (sorted under SortedStorage)
+        std::vector<size_t> insertionStamps;  // SortedStorage only: generation at which data[i] was added
+        size_t generation = 0;  // Bumped by every add()/remove(), used to detect stale caches
+        size_t sortedPrefix = 0;  // Length of the prefix of data known to be non-decreasing
+
+        /**
+         * @brief The cached sorted view and search index. Const methods build them on
+         *        demand, so they carry their own mutex; a copy locks the source and
+         *        gets a new mutex.
+         */
+        struct SortedViewCache {
+            mutable std::mutex mutex;
+            std::shared_ptr<std::vector<size_t>> snapshot;  // Sorted permutation of data[0, covers)
+            size_t covers = 0;  // How many leading elements of data the snapshot covers
+            std::optional<detail::EytzingerIndex<T>> searchIndex;  // Optional search copy of the sorted order, see enableSearchIndex()
+            std::atomic<size_t> searchIndexFor{0};  // Generation + 1 the search index was published for, 0 if none
+            std::shared_ptr<const std::vector<size_t>> insertionView;  // SortedStorage only: data indices in insertion order
+            size_t insertionViewFor = 0;  // Generation + 1 the insertion view was built for, 0 if none
+
+            SortedViewCache() = default;
+
+            SortedViewCache(const SortedViewCache& other) {
+                std::lock_guard<std::mutex> lock(other.mutex);
+                snapshot = other.snapshot;
+                covers = other.covers;
+                searchIndex = other.searchIndex;
+                searchIndexFor = other.searchIndexFor.load();
+                insertionView = other.insertionView;
+                insertionViewFor = other.insertionViewFor;
+            }
+
+            SortedViewCache& operator=(const SortedViewCache& other) {
+                if (this != &other) {
+                    std::scoped_lock lock(mutex, other.mutex);
+                    snapshot = other.snapshot;
+                    covers = other.covers;
+                    searchIndex = other.searchIndex;
+                    searchIndexFor = other.searchIndexFor.load();
+                    insertionView = other.insertionView;
+                    insertionViewFor = other.insertionViewFor;
+                }
+                return *this;
+            }
+
+            // Moving needs exclusive access to both sides, so it takes no lock; other is left empty
+            SortedViewCache(SortedViewCache&& other) noexcept
+                : snapshot(std::move(other.snapshot)), covers(std::exchange(other.covers, 0)),
+                  searchIndex(std::move(other.searchIndex)), searchIndexFor(other.searchIndexFor.exchange(0)),
+                  insertionView(std::move(other.insertionView)), insertionViewFor(std::exchange(other.insertionViewFor, 0))
+            {
+            }
+
+            SortedViewCache& operator=(SortedViewCache&& other) noexcept {
+                if (this != &other) {
+                    snapshot = std::move(other.snapshot);
+                    covers = std::exchange(other.covers, 0);
+                    searchIndex = std::move(other.searchIndex);
+                    searchIndexFor = other.searchIndexFor.exchange(0);
+                    insertionView = std::move(other.insertionView);
+                    insertionViewFor = std::exchange(other.insertionViewFor, 0);
+                }
+                return *this;
+            }
+        };
+
+        mutable SortedViewCache viewCache;
+        size_t parallelSortThreshold = detail::defaultParallelSortThreshold;  // From this size the view is sorted in parallel
+        std::optional<OrderStatisticTree<T>> statistics;  // Optional rank/select index, see enableOrderStatistics()
+
+        // True while data is non-decreasing, i.e. already in ascending order
+        bool isDataSorted() const {
+            return keepsSorted || sortedPrefix == data.size();
+        }
+
+        /**
+         * @brief SortedStorage only: data indices in insertion order, i.e. data
+         *        sorted by insertion stamp. add() and remove() only insert and erase
+         *        stamps next to their elements, so the view is rebuilt (with the radix
+         *        kernel, O(n)) on the first call after a change and shared until the next.
+         *        Safe to call from several threads at once, like sortedView().
+         */
+        std::shared_ptr<const std::vector<size_t>> insertionView() const {
+            std::lock_guard<std::mutex> lock(viewCache.mutex);
+            if (viewCache.insertionViewFor != generation + 1) {
+                auto order = std::make_shared<std::vector<size_t>>(data.size());
+                std::iota(order->begin(), order->end(), size_t{0});
+                detail::sortIndex(insertionStamps, *order);
+                viewCache.insertionView = std::move(order);
+                viewCache.insertionViewFor = generation + 1;
+            }
+            return viewCache.insertionView;
+        }
+
+        // True when the ascending order is known without sorting
+        bool hasFreshSortedView() const {
+            std::lock_guard<std::mutex> lock(viewCache.mutex);
+            return isDataSorted() || (viewCache.snapshot && viewCache.covers == data.size());
+        }
+
+        /**
+         * @brief Returns the sorted view of the container as a permutation of indices
+         *        into data, bringing it up to date first if needed.
+         *
+         * data[view[0]] is the smallest element, data[view[size - 1]] the largest.
+         * Sorting indices instead of a copy of the elements keeps the view at one
+         * size_t per element no matter how expensive T is to copy.
+         * Integral and floating-point T get radix/SIMD kernels, see detail::sortIndex(),
+         * and large containers are sorted on the shared thread pool.
+         * All value-ordered iterators (and their begin/end pairs) share this view,
+         * so repeated traversals of an unchanged container do not sort again.
+         *
+         * The view is maintained incrementally: remove() patches it in place, and
+         * elements added since it was last built (the tail of data) are sorted on
+         * their own and merged in, which costs O(n + t log t) for t new elements.
+         * The first view starts from the prefix of data that is already sorted.
+         *
+         * Safe to call from several threads at once: building and swapping the
+         * cache happens under its mutex, and a published view is never modified.
+         *
+         * @return nullptr while data itself is in ascending order: the view is then
+         *         the identity and callers walk data directly, with no copy and no sort.
+         */
+        std::shared_ptr<const std::vector<size_t>> sortedView() const {
+            if (isDataSorted()) {
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(viewCache.mutex);
+            if (!viewCache.snapshot) {
+                viewCache.snapshot = std::make_shared<std::vector<size_t>>(sortedPrefix);
+                std::iota(viewCache.snapshot->begin(), viewCache.snapshot->end(), size_t{0});
+                viewCache.covers = sortedPrefix;
+            }
+            if (viewCache.covers < data.size()) {
+                std::vector<size_t> tail(data.size() - viewCache.covers);
+                std::iota(tail.begin(), tail.end(), viewCache.covers);
+                if (tail.size() >= parallelSortThreshold) {
+                    detail::parallelSortIndex(data, tail);
+                } else {
+                    detail::sortIndex(data, tail);
+                }
+
+                // Iterators may still hold the old view, so the merge always goes to a new one
+                auto merged = std::make_shared<std::vector<size_t>>(data.size());
+                std::merge(viewCache.snapshot->begin(), viewCache.snapshot->end(), tail.begin(), tail.end(), merged->begin(),
+                           [this](size_t a, size_t b) { return data[a] < data[b]; });
+                viewCache.snapshot = std::move(merged);
+                viewCache.covers = data.size();
+            }
+            return viewCache.snapshot;
+        }
+
+        /**
+         * @brief Drops every occurrence of item from the sorted view before remove()
+         *        erases them from data, and shifts the remaining indices to match.
+         *
+         * The covered occurrences are found with a binary search; only the tail that
+         * the view does not cover yet is scanned.
+         */
+        void dropFromSortedView(const T& item) {
+            if (!viewCache.snapshot) {
+                return;
+            }
+            std::vector<size_t>& view = *viewCache.snapshot;
+            auto first = std::lower_bound(view.begin(), view.end(), item,
+                                          [this](size_t i, const T& value) { return data[i] < value; });
+            auto last = std::upper_bound(first, view.end(), item,
+                                         [this](const T& value, size_t i) { return value < data[i]; });
+
+            std::vector<size_t> removed(first, last);
+            std::sort(removed.begin(), removed.end());
+            size_t removedCovered = removed.size();
+            for (size_t i = viewCache.covers; i < data.size(); ++i) {
+                if (data[i] == item) {
+                    removed.push_back(i);
+                }
+            }
+            if (removed.empty()) {
+                return;
+            }
+
+            auto patched = std::make_shared<std::vector<size_t>>();
+            patched->reserve(view.size() - removedCovered);
+            for (auto it = view.begin(); it != view.end(); ++it) {
+                if (it == first) {
+                    it = last;
+                    if (it == view.end()) {
+                        break;
+                    }
+                }
+                size_t shift = static_cast<size_t>(std::upper_bound(removed.begin(), removed.end(), *it) - removed.begin());
+                patched->push_back(*it - shift);
+            }
+            viewCache.snapshot = std::move(patched);
+            viewCache.covers -= removedCovered;
+        }
+
+        /**
+         * @brief Binary search over the sorted view: returns how many elements, in
+         *        ascending order, satisfy before (which must hold for a prefix).
+         *        Arithmetic T uses the branchless search, see detail::branchlessPartitionPoint().
+         *        With enableSearchIndex() the Eytzinger copy is searched instead,
+         *        rebuilt first if add()/remove() ran since it was built.
+         */
+        template<typename Before>
+        size_t partitionPointInView(Before before) const {
+            const T* values = data.data();
+            if (viewCache.searchIndex) {
+                // Once published for this generation, the index is only read until the next add()/remove()
+                if (viewCache.searchIndexFor.load(std::memory_order_acquire) != generation + 1) {
+                    auto view = sortedView();
+                    std::lock_guard<std::mutex> lock(viewCache.mutex);
+                    if (!viewCache.searchIndex->isFreshFor(generation)) {
+                        viewCache.searchIndex->rebuild(generation, data.size(), [&](size_t rank) -> const T& {
+                            return values[view ? (*view)[rank] : rank];
+                        });
+                    }
+                    viewCache.searchIndexFor.store(generation + 1, std::memory_order_release);
+                }
+                return viewCache.searchIndex->partitionPoint(before);
+            }
+            auto view = sortedView();
+            if constexpr (std::is_arithmetic<T>::value) {
+                if (!view) {
+                    return detail::branchlessPartitionPoint(data.size(), [&](size_t rank) { return before(values[rank]); });
+                }
+                const size_t* index = view->data();
+                return detail::branchlessPartitionPoint(data.size(), [&](size_t rank) { return before(values[index[rank]]); });
+            } else {
+                if (!view) {
+                    return static_cast<size_t>(std::partition_point(data.begin(), data.end(), before) - data.begin());
+                }
+                return static_cast<size_t>(std::partition_point(view->begin(), view->end(),
+                                           [&](size_t i) { return before(values[i]); }) - view->begin());
+            }
+        }
+
+        // Number of elements smaller than value, by binary search over the sorted view
+        size_t countLessInView(const T& value) const {
+            return partitionPointInView([&value](const T& element) { return element < value; });
+        }
+
+        // Number of elements not greater than value, by binary search over the sorted view
+        size_t countLessOrEqualInView(const T& value) const {
+            return partitionPointInView([&value](const T& element) { return !(value < element); });
+        }
+
+        // Copies the k smallest (or largest) elements, in traversal order
+        std::vector<T> selectExtremes(size_t k, bool largest) const {
+            k = std::min(k, data.size());
+            std::vector<T> result;
+            result.reserve(k);
+            if (hasFreshSortedView()) {
+                auto view = sortedView();
+                for (size_t i = 0; i < k; ++i) {
+                    size_t rank = largest ? data.size() - 1 - i : i;
+                    result.push_back(data[view ? (*view)[rank] : rank]);
+                }
+                return result;
+            }
+            detail::LazySortedIndex<T> lazy(data, largest);
+            for (size_t i = 0; i < k; ++i) {
+                result.push_back(data[lazy.at(i)]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the elements at the given ranks of the ascending order.
+         *
+         * Reads the order-statistic index or a fresh sorted view when there is one.
+         * Otherwise runs one shared multi-rank introselect over a scratch copy:
+         * of the values for arithmetic T (better locality), of indices otherwise.
+         * Expected O(n log r) for r ranks, without sorting the container.
+         *
+         * @param ranks Sorted, unique ranks, all below size().
+         */
+        std::vector<T> selectRanks(const std::vector<size_t>& ranks) const {
+            std::vector<T> result;
+            result.reserve(ranks.size());
+            if (statistics || hasFreshSortedView()) {
+                for (size_t rank : ranks) {
+                    result.push_back(select(rank));
+                }
+                return result;
+            }
+            if constexpr (std::is_arithmetic<T>::value) {
+                std::vector<T> scratch(data);
+                detail::multiSelect(scratch.begin(), 0, scratch.size(), ranks.data(), ranks.data() + ranks.size(), std::less<T>());
+                for (size_t rank : ranks) {
+                    result.push_back(scratch[rank]);
+                }
+            } else {
+                std::vector<size_t> scratch(data.size());
+                std::iota(scratch.begin(), scratch.end(), size_t{0});
+                detail::multiSelect(scratch.begin(), 0, scratch.size(), ranks.data(), ranks.data() + ranks.size(),
+                                    [this](size_t a, size_t b) { return data[a] < data[b]; });
+                for (size_t rank : ranks) {
+                    result.push_back(data[scratch[rank]]);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Builds an ascending permutation of data under compare applied to
+         *        projection(element), by decorate-sort-undecorate: each projected
+         *        key is computed once into a key array, the indices are sorted by
+         *        key, and the keys are dropped. Plain less-than orderings go through
+         *        detail::sortIndex() and so get the radix/SIMD kernels for arithmetic keys.
+         *        Elements with equal keys come in unspecified order.
+         */
+        template<typename Compare, typename Projection>
+        std::shared_ptr<const std::vector<size_t>> sortedViewBy(Compare compare, Projection projection) const {
+            auto order = std::make_shared<std::vector<size_t>>(data.size());
+            std::iota(order->begin(), order->end(), size_t{0});
+
+            using Key = std::decay_t<std::invoke_result_t<Projection&, const T&>>;
+            constexpr bool plainLess = std::is_same<Compare, std::ranges::less>::value
+                                    || std::is_same<Compare, std::less<>>::value
+                                    || std::is_same<Compare, std::less<Key>>::value;
+            if constexpr (std::is_same<Projection, std::identity>::value) {
+                // No projection: compare the elements themselves, no key array needed
+                if constexpr (plainLess) {
+                    detail::sortIndex(data, *order);
+                } else {
+                    std::sort(order->begin(), order->end(),
+                              [&](size_t a, size_t b) { return std::invoke(compare, data[a], data[b]); });
+                }
+            } else {
+                std::vector<Key> keys;
+                keys.reserve(data.size());
+                for (const T& element : data) {
+                    keys.push_back(std::invoke(projection, element));
+                }
+                if constexpr (plainLess) {
+                    detail::sortIndex(keys, *order);
+                } else {
+                    std::sort(order->begin(), order->end(),
+                              [&](size_t a, size_t b) { return std::invoke(compare, keys[a], keys[b]); });
+                }
+            }
+            return order;
+        }
+
+        // Leaves a moved-from container empty, with every cache describing the empty data
+        void resetAfterMove() noexcept {
+            data.clear();
+            insertionStamps.clear();
+            sortedPrefix = 0;
+            ++generation;  // A search index that moved along with the elements is stale here
+            viewCache.snapshot.reset();
+            viewCache.covers = 0;
+            viewCache.searchIndexFor = 0;
+            viewCache.insertionView.reset();
+            viewCache.insertionViewFor = 0;
+            if (statistics) {
+                statistics.emplace();
+            }
+        }
 
     public:
+        MyContainer() = default;
+        MyContainer(const MyContainer&) = default;
+        MyContainer& operator=(const MyContainer&) = default;
+
+        /**
+         * @brief Takes other's elements and caches. other is left empty (keeping its
+         *        enabled indices) and can be used again.
+         */
+        MyContainer(MyContainer&& other) noexcept
+            : data(std::move(other.data)), insertionStamps(std::move(other.insertionStamps)),
+              generation(other.generation), sortedPrefix(other.sortedPrefix), viewCache(std::move(other.viewCache)),
+              parallelSortThreshold(other.parallelSortThreshold), statistics(std::move(other.statistics))
+        {
+            other.resetAfterMove();
+        }
+
+        MyContainer& operator=(MyContainer&& other) noexcept {
+            if (this != &other) {
+                data = std::move(other.data);
+                insertionStamps = std::move(other.insertionStamps);
+                generation = other.generation;
+                sortedPrefix = other.sortedPrefix;
+                viewCache = std::move(other.viewCache);
+                parallelSortThreshold = other.parallelSortThreshold;
+                statistics = std::move(other.statistics);
+                other.resetAfterMove();
+            }
+            return *this;
+        }
+
          /**
          * @brief Adds an element to the container.
          * @param value The value to insert.
          */
         void add(const T& item) {
+            if constexpr (keepsSorted) {
+                // After any equal elements, so equal values keep their insertion order
+                size_t pos = static_cast<size_t>(std::upper_bound(data.begin(), data.end(), item) - data.begin());
+                data.insert(data.begin() + static_cast<std::ptrdiff_t>(pos), item);
+                insertionStamps.insert(insertionStamps.begin() + static_cast<std::ptrdiff_t>(pos), generation);
+                if (statistics) {
+                    statistics->insert(item);
+                }
+                ++generation;
+                return;
+            }
+            if (isDataSorted() && (data.empty() || !(item < data.back()))) {
+                ++sortedPrefix;
+            }
             data.push_back(item);
+            if (statistics) {
+                statistics->insert(item);
+            }
+            ++generation;
         }
 
          /**
@@ -34,12 +500,38 @@ namespace dael_containers {
          * @throws std::runtime_error If the element is not found.
          */
         void remove(const T& item) {
+            if constexpr (keepsSorted) {
+                auto range = std::equal_range(data.begin(), data.end(), item);
+                if (range.first == range.second) {
+                    throw std::runtime_error("Item not found in container.");
+                }
+                auto stamps = insertionStamps.begin() + (range.first - data.begin());
+                insertionStamps.erase(stamps, stamps + (range.second - range.first));
+                data.erase(range.first, range.second);
+                if (statistics) {
+                    statistics->eraseAll(item);
+                }
+                ++generation;
+                return;
+            }
+            // Occurrences inside the sorted prefix are adjacent, so they are found by binary search
+            auto prefixEnd = data.begin() + static_cast<std::ptrdiff_t>(sortedPrefix);
+            auto inPrefix = std::equal_range(data.begin(), prefixEnd, item);
+            size_t removedFromPrefix = static_cast<size_t>(inPrefix.second - inPrefix.first);
+            dropFromSortedView(item);
+
             auto originalSize = data.size();
             data.erase(std::remove(data.begin(), data.end(), item), data.end());//this line moving all "item" to the end of the vector (with commend "remove") and then erase them (with commend "erase").
 
             if (data.size() == originalSize) {
                 throw std::runtime_error("Item not found in container.");
             }
+            // Erasing keeps the sorted prefix sorted
+            sortedPrefix -= removedFromPrefix;
+            if (statistics) {
+                statistics->eraseAll(item);
+            }
+            ++generation;
         }
 
         /**
@@ -50,13 +542,227 @@ namespace dael_containers {
             return data.size();
         }
 
+        /**
+        * @brief Reserves room for capacity elements, so filling a very large
+        *        container does not reallocate (and briefly double) its storage.
+        */
+        void reserve(size_t capacity) {
+            data.reserve(capacity);
+            if constexpr (keepsSorted) {
+                insertionStamps.reserve(capacity);
+            }
+        }
+
+        /**
+        * @brief Sets the container size from which the sorted view used by the
+        *        value-ordered iterators is built with a parallel sort.
+        *        The traversal order is the same either way.
+        * @param threshold Minimum number of elements for the parallel path.
+        */
+        void setParallelSortThreshold(size_t threshold) {
+            parallelSortThreshold = threshold;
+        }
+
+        /**
+        * @brief Builds the order-statistic index (a counted B+-tree) and keeps it up
+        *        to date on every add()/remove() from now on, at O(log n) each.
+        *        select(), rank() and countLess() then answer in O(log n) even while
+        *        the container keeps changing, without rebuilding the sorted view.
+        */
+        void enableOrderStatistics() {
+            if (statistics) {
+                return;
+            }
+            std::vector<T> sorted;
+            sorted.reserve(data.size());
+            auto view = sortedView();
+            for (size_t rank = 0; rank < data.size(); ++rank) {
+                sorted.push_back(data[view ? (*view)[rank] : rank]);
+            }
+            statistics.emplace(sorted);
+        }
+
+        /**
+        * @brief Drops the order-statistic index; queries fall back to the sorted view.
+        */
+        void disableOrderStatistics() {
+            statistics.reset();
+        }
+
+        /**
+        * @brief True if enableOrderStatistics() is in effect.
+        */
+        bool hasOrderStatistics() const {
+            return statistics.has_value();
+        }
+
+        /**
+        * @brief Keeps an Eytzinger-layout (BFS-order) copy of the sorted order for the
+        *        range queries (lowerBound(), countInRange(), ...), searched with
+        *        software prefetching. Worth it for large containers queried many
+        *        times between changes: the copy is rebuilt in O(n) on the first
+        *        query after an add()/remove(). Costs one T and one size_t per element.
+        */
+        void enableSearchIndex() {
+            if (!viewCache.searchIndex) {
+                viewCache.searchIndex.emplace();
+                viewCache.searchIndexFor = 0;
+            }
+        }
+
+        /**
+        * @brief Drops the search index; range queries fall back to binary search over the sorted view.
+        */
+        void disableSearchIndex() {
+            viewCache.searchIndex.reset();
+            viewCache.searchIndexFor = 0;
+        }
+
+        /**
+        * @brief True if enableSearchIndex() is in effect.
+        */
+        bool hasSearchIndex() const {
+            return viewCache.searchIndex.has_value();
+        }
+
+        /**
+        * @brief Direct access to the order-statistic index, e.g. for sorted
+        *        iteration from an arbitrary key with lowerBound().
+        * @throws std::logic_error If the index is not enabled.
+        */
+        const OrderStatisticTree<T>& orderStatistics() const {
+            if (!statistics) {
+                throw std::logic_error("Order statistics are not enabled.");
+            }
+            return *statistics;
+        }
+
+        /**
+        * @brief Returns the k-th smallest element (k = 0 is the smallest).
+        *        O(log n) with the order-statistic index, otherwise read from the sorted view.
+        * @throws std::out_of_range If k >= size().
+        */
+        const T& select(size_t k) const {
+            if (statistics) {
+                return statistics->select(k);
+            }
+            if (k >= data.size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            auto view = sortedView();
+            return data[view ? (*view)[k] : k];
+        }
+
+        /**
+        * @brief Returns how many elements are strictly smaller than value.
+        *        O(log n) with the order-statistic index, otherwise a binary search
+        *        over the sorted view.
+        */
+        size_t countLess(const T& value) const {
+            return statistics ? statistics->countLess(value) : countLessInView(value);
+        }
+
+        /**
+        * @brief Returns the rank of value: the position of its first occurrence
+        *        in ascending order.
+        * @throws std::runtime_error If the element is not found.
+        */
+        size_t rank(const T& value) const {
+            size_t below = countLess(value);
+            if (below == data.size() || value < select(below)) {
+                throw std::runtime_error("Item not found in container.");
+            }
+            return below;
+        }
+
+        /**
+        * @brief Returns the k-th smallest element (k = 0 is the smallest) in expected
+        *        O(n) by introselect, without building the sorted view.
+        * @throws std::out_of_range If k >= size().
+        */
+        T nthSmallest(size_t k) const {
+            if (k >= data.size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            return selectRanks({k}).front();
+        }
+
+        /**
+        * @brief Returns the median; for an even size, the lower of the two middle elements.
+        * @throws std::out_of_range If the container is empty.
+        */
+        T median() const {
+            if (data.empty()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            return nthSmallest((data.size() - 1) / 2);
+        }
+
+        /**
+        * @brief Returns the requested percentiles (nearest-rank: the p-th percentile is
+        *        the element at rank ceil(p / 100 * size()) - 1, and p = 0 the smallest),
+        *        in the order they were asked for. All of them share one selection pass.
+        * @throws std::invalid_argument If a percentile is outside [0, 100].
+        * @throws std::out_of_range If the container is empty.
+        */
+        std::vector<T> percentiles(const std::vector<double>& requested) const {
+            if (data.empty() && !requested.empty()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            std::vector<size_t> ranks;
+            ranks.reserve(requested.size());
+            for (double p : requested) {
+                if (!(p >= 0.0 && p <= 100.0)) {
+                    throw std::invalid_argument("Percentile must be between 0 and 100");
+                }
+                // Multiplying first keeps p * size exact for whole-number percentiles, so ceil() does not round up
+                double position = std::ceil(p * static_cast<double>(data.size()) / 100.0);
+                ranks.push_back(position < 1.0 ? 0 : std::min(static_cast<size_t>(position) - 1, data.size() - 1));
+            }
+
+            std::vector<size_t> distinct(ranks);
+            std::sort(distinct.begin(), distinct.end());
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            std::vector<T> selected = selectRanks(distinct);
+
+            std::vector<T> result;
+            result.reserve(ranks.size());
+            for (size_t rank : ranks) {
+                auto at = std::lower_bound(distinct.begin(), distinct.end(), rank) - distinct.begin();
+                result.push_back(selected[static_cast<size_t>(at)]);
+            }
+            return result;
+        }
+
+        /**
+        * @brief Returns the k largest elements, largest first.
+        *        Costs O(n + k log n) unless the sorted view is already built.
+        * @param k How many elements to return (clamped to size()).
+        */
+        std::vector<T> topK(size_t k) const {
+            return selectExtremes(k, true);
+        }
+
+        /**
+        * @brief Returns the k smallest elements, smallest first.
+        *        Costs O(n + k log n) unless the sorted view is already built.
+        * @param k How many elements to return (clamped to size()).
+        */
+        std::vector<T> bottomK(size_t k) const {
+            return selectExtremes(k, false);
+        }
+
          /**
          * @brief Overloads the output stream operator for displaying the container contents.
          */
-        friend std::ostream& operator<<(std::ostream& os, const MyContainer<T>& container) {
+        friend std::ostream& operator<<(std::ostream& os, const MyContainer& container) {
+            std::shared_ptr<const std::vector<size_t>> order;
+            if constexpr (keepsSorted) {
+                order = container.insertionView();
+            }
             os << "[";
             for (size_t i = 0; i < container.data.size(); ++i) {
-                os << container.data[i];
+                os << container.data[order ? (*order)[i] : i];
                 if (i < container.data.size() - 1) {
                     os << ", ";
                 }
@@ -65,119 +771,186 @@ namespace dael_containers {
             return os;
         }
 
-    //---------------------------AscendingOrderIterator-----------------------------------
+    //---------------------------PolicyIterator-----------------------------------
 
      /**
-     * @class AscendingOrder
-     * @brief Iterates through the container from smallest to largest element.
+     * @class PolicyIterator
+     * @brief Random-access iterator over the order described by Policy (see OrderPolicies.hpp).
+     *
+     * Value-ordered policies map each step to a rank of the shared sorted view (or,
+     * in TraversalMode::Lazy, ask the policy's lazy index); the others map it to a
+     * position in insertion order. Members a policy does not need take no space.
      */
-    class AscendingOrderIterator {
+    template<typename Policy>
+    class PolicyIterator : public detail::RandomAccessFacade<PolicyIterator<Policy>, T> {
     private:
-        const MyContainer<T>& container;
-        std::vector<T> sortedData;
-        size_t index;
+        static constexpr bool supportsLazy = LazyOrderPolicy<Policy, T>;
+
+        const MyContainer* container = nullptr;
+        [[no_unique_address]] std::conditional_t<Policy::valueOrdered || keepsSorted, detail::SortedViewHandle, detail::NoSortedView> view;
+        [[no_unique_address]] typename detail::LazyIndexOf<Policy, T>::type lazyIndex;  // Used instead of the view in lazy mode
+        size_t step = 0;
 
     public:
-        AscendingOrderIterator(const MyContainer<T>& cont, bool isEnd = false)
-            : container(cont), sortedData(cont.data), index(0)
+        PolicyIterator() = default;
+
+        /**
+         * @param mode Lazy produces elements on demand instead of sorting up front
+         *             (policies with a lazy index only). End iterators never sort,
+         *             whatever the mode.
+         */
+        PolicyIterator(const MyContainer& cont, bool isEnd = false, TraversalMode mode = TraversalMode::Snapshot)
+            : container(&cont)
         {
-            std::sort(sortedData.begin(), sortedData.end());
+            static_cast<void>(mode);
             if (isEnd) {
-                index = sortedData.size(); 
+                step = cont.size();
+                return;
+            }
+            if constexpr (supportsLazy) {
+                if (mode == TraversalMode::Lazy && !cont.hasFreshSortedView()) {
+                    lazyIndex = Policy::makeLazy(cont.data);
+                    return;
+                }
+            }
+            if constexpr (Policy::valueOrdered) {
+                view.sortedIndex = cont.sortedView();
+                view.resolved = true;
+            } else if constexpr (keepsSorted) {
+                view.sortedIndex = cont.insertionView();
+                view.resolved = true;
             }
         }
 
-        // Dereferencing to get current value
-        const T& operator*() const {
-            return sortedData.at(index);
+        /**
+         * @brief Maps steps to ranks of the given ascending permutation instead of
+         *        the container's own sorted view (see ascendingBy()).
+         */
+        PolicyIterator(const MyContainer& cont, std::shared_ptr<const std::vector<size_t>> order, bool isEnd = false)
+            requires Policy::valueOrdered
+            : container(&cont), step(isEnd ? cont.size() : 0)
+        {
+            view.sortedIndex = std::move(order);
+            view.resolved = true;
         }
 
-        // Prefix increment to advance iterator
-        AscendingOrderIterator& operator++() {
-            ++index;
-            return *this;
+        // Dereferencing to get current value
+        const T& operator*() const {
+            if (checksBounds && step >= container->data.size()) {
+                throw std::out_of_range("Iterator out of bounds");
+            }
+            if constexpr (supportsLazy) {
+                if (lazyIndex) {
+                    return container->data[lazyIndex->at(step)];
+                }
+            }
+            if constexpr (Policy::valueOrdered) {
+                if (!view.resolved) {
+                    view.sortedIndex = container->sortedView();
+                    view.resolved = true;
+                }
+                // Without a view data is already ascending and the rank is the data index
+                size_t rank = Policy::map(step, container->data.size());
+                return container->data[view.sortedIndex ? (*view.sortedIndex)[rank] : rank];
+            } else if constexpr (keepsSorted) {
+                if (!view.resolved) {
+                    view.sortedIndex = container->insertionView();
+                    view.resolved = true;
+                }
+                return container->data[(*view.sortedIndex)[Policy::map(step, container->data.size())]];
+            } else {
+                return container->data[Policy::map(step, container->data.size())];
+            }
         }
 
-        // Inequality check
-        bool operator!=(const AscendingOrderIterator& other) const {
-            return index != other.index;
+        // Position in the traversal: 0 for the first element, size() for end
+        std::ptrdiff_t position() const {
+            return static_cast<std::ptrdiff_t>(step);
         }
 
-        // Equality check
-        bool operator==(const AscendingOrderIterator& other) const {
-            return index == other.index;
+        // Moves n elements forward (backward when n is negative)
+        void advance(std::ptrdiff_t n) {
+            step += static_cast<size_t>(n);
         }
     };
 
-    // Helper methods for begin/end of the iterator
-    AscendingOrderIterator beginAscending() const {
-        return AscendingOrderIterator(*this);
+    // Helper methods for begin/end of any policy's iterator
+    template<typename Policy>
+    PolicyIterator<Policy> beginOf(TraversalMode mode = TraversalMode::Snapshot) const {
+        return PolicyIterator<Policy>(*this, false, mode);
     }
 
-    AscendingOrderIterator endAscending() const {
-        return AscendingOrderIterator(*this, true);
+    template<typename Policy>
+    PolicyIterator<Policy> endOf() const {
+        return PolicyIterator<Policy>(*this, true);
     }
 
-
-    //---------------------------DescendingOrderIterator-----------------------------------
+    /**
+    * @brief The traversal described by Policy as a view.
+    * @param mode Lazy produces elements on demand (policies with a lazy index only).
+    */
+    template<typename Policy>
+    std::ranges::subrange<PolicyIterator<Policy>> view(TraversalMode mode = TraversalMode::Snapshot) const {
+        return std::ranges::subrange(beginOf<Policy>(mode), endOf<Policy>());
+    }
 
     /**
-    * @class DescendingOrder
-    * @brief Iterates through the container from largest to smallest element.
+    * @brief The traversal named by Order as a view (same as ascending(), order(), ...).
     */
-    class DescendingOrderIterator {
-        private:
+    template<IterationOrder Order>
+    auto view(TraversalMode mode = TraversalMode::Snapshot) const {
+        return view<typename PolicyFor<Order>::type>(mode);
+    }
+
+    //---------------------------AscendingOrderIterator-----------------------------------
 
-            const MyContainer<T>& container;
-            std::vector<T> sortedData;
-            int index;  
+     /**
+     * @class AscendingOrder
+     * @brief Iterates through the container from smallest to largest element.
+     */
+    using AscendingOrderIterator = PolicyIterator<orders::Ascending>;
 
-        public:
+    // Helper methods for begin/end of the iterator
+    AscendingOrderIterator beginAscending(TraversalMode mode = TraversalMode::Snapshot) const {
+        return beginOf<orders::Ascending>(mode);
+    }
 
-            DescendingOrderIterator(const MyContainer<T>& cont, bool isEnd = false): container(cont), sortedData(cont.data)
-            {
-                std::sort(sortedData.begin(), sortedData.end());
-                if (isEnd || sortedData.empty()) {
-                    index = -1;
-                } else {
-                    index = static_cast<int>(sortedData.size()) - 1;
-                }
-            }
+    AscendingOrderIterator endAscending() const {
+        return endOf<orders::Ascending>();
+    }
 
-            // Dereferencing to get current value
-            const T& operator*() const {
-                if (index < 0 || index >= static_cast<int>(sortedData.size())) {
-                    throw std::out_of_range("Iterator out of bounds");
-                }
-                return sortedData[index];
-            }
+    /**
+    * @brief The ascending traversal as a view, e.g. c.ascending() | std::views::take(3).
+    * @param mode Lazy produces elements on demand instead of sorting up front.
+    */
+    auto ascending(TraversalMode mode = TraversalMode::Snapshot) const {
+        return view<orders::Ascending>(mode);
+    }
 
-            // Prefix increment to advance iterator
-            DescendingOrderIterator& operator++() {
-                if (index >= 0) {
-                    --index;
-                }
-                return *this;
-            }
 
-            // Inequality check
-            bool operator!=(const DescendingOrderIterator& other) const {
-                return index != other.index;
-            }
+    //---------------------------DescendingOrderIterator-----------------------------------
 
-            // Equality check
-            bool operator==(const DescendingOrderIterator& other) const {
-                return index == other.index;
-            }
-    };
+    /**
+    * @class DescendingOrder
+    * @brief Iterates through the container from largest to smallest element.
+    */
+    using DescendingOrderIterator = PolicyIterator<orders::Descending>;
 
     // Helper methods for begin/end of the iterator
-    DescendingOrderIterator beginDescending() const {
-        return DescendingOrderIterator(*this);
+    DescendingOrderIterator beginDescending(TraversalMode mode = TraversalMode::Snapshot) const {
+        return beginOf<orders::Descending>(mode);
     }
 
     DescendingOrderIterator endDescending() const {
-        return DescendingOrderIterator(*this, true);
+        return endOf<orders::Descending>();
+    }
+
+    /**
+    * @brief The descending traversal as a view.
+    * @param mode Lazy produces elements on demand instead of sorting up front.
+    */
+    auto descending(TraversalMode mode = TraversalMode::Snapshot) const {
+        return view<orders::Descending>(mode);
     }
 
 
@@ -188,81 +961,23 @@ namespace dael_containers {
      * @class SideCrossOrder
      * @brief Alternates between the smallest and largest elements.
      */
-    class SideCrossOrderIterator {
-        private:
-            const MyContainer<T>& container;
-            std::vector<T> sortedData;
-            size_t leftIndex;   // Index from the beginning
-            size_t rightIndex;  // Index from the end
-            bool takeFromLeft;  // Whether to take from the left side
-            size_t currentStep; // How many steps we've taken
-
-        public:
-            SideCrossOrderIterator(const MyContainer<T>& cont, bool isEnd = false)
-                : container(cont), sortedData(cont.data), leftIndex(0), 
-                rightIndex(cont.size() > 0 ? cont.size() - 1 : 0), 
-                takeFromLeft(true), currentStep(0)
-            {
-                std::sort(sortedData.begin(), sortedData.end());
-                if (isEnd || sortedData.empty()) {
-                    currentStep = sortedData.size();  // Points to end
-                }
-            }
-
-            // Dereferencing to get current value
-            const T& operator*() const {
-                if (currentStep >= sortedData.size()) {
-                    throw std::out_of_range("Iterator out of bounds");
-                }
-                
-                if (takeFromLeft) {
-                    return sortedData[leftIndex];
-                } else {
-                    return sortedData[rightIndex];
-                }
-            }
-
-            // Prefix increment to advance iterator
-            SideCrossOrderIterator& operator++() {
-                if (currentStep >= sortedData.size()) {
-                    return *this; // Already at end
-                }
-
-                // Move indices according to what we took
-                if (takeFromLeft) {
-                    leftIndex++;
-                } else {
-                    if (rightIndex > 0) rightIndex--;
-                }
-
-                currentStep++;
-                
-                // Switch sides for next step (if we haven't reached the end)
-                if (currentStep < sortedData.size()) {
-                    takeFromLeft = !takeFromLeft;
-                }
-
-                return *this;
-            }
-
-            // Inequality check
-            bool operator!=(const SideCrossOrderIterator& other) const {
-                return currentStep != other.currentStep;
-            }
-
-            // Equality check
-            bool operator==(const SideCrossOrderIterator& other) const {
-                return currentStep == other.currentStep;
-            }
-    };
+    using SideCrossOrderIterator = PolicyIterator<orders::SideCross>;
 
     // Helper methods for begin/end of the iterator
-    SideCrossOrderIterator beginSideCross() const {
-        return SideCrossOrderIterator(*this);
+    SideCrossOrderIterator beginSideCross(TraversalMode mode = TraversalMode::Snapshot) const {
+        return beginOf<orders::SideCross>(mode);
     }
 
     SideCrossOrderIterator endSideCross() const {
-        return SideCrossOrderIterator(*this, true);
+        return endOf<orders::SideCross>();
+    }
+
+    /**
+    * @brief The side-cross traversal as a view.
+    * @param mode Lazy extracts min/max pairs from a min-max heap on demand instead of sorting up front.
+    */
+    auto sideCross(TraversalMode mode = TraversalMode::Snapshot) const {
+        return view<orders::SideCross>(mode);
     }
 
 
@@ -272,56 +987,22 @@ namespace dael_containers {
      * @class ReverseOrder
      * @brief Iterates through the container in reverse of insertion order.
      */
-    class ReverseOrderIterator {
-        private:
-            const MyContainer<T>& container;
-            int index; // Current position in the original data (using int to allow -1)
-            
-        public:
-            ReverseOrderIterator(const MyContainer<T>& cont, bool isEnd = false): container(cont), index(cont.size() > 0 ? static_cast<int>(cont.size()) - 1 : -1)
-            {
-                if (isEnd || cont.size() == 0) {
-                    index = -1; // -1 indicates end
-                }
-            }
-
-            // Dereferencing to get current value
-            const T& operator*() const {
-                if (index < 0 || index >= static_cast<int>(container.data.size())) {
-                    throw std::out_of_range("Iterator out of bounds");
-                }
-                return container.data[index];
-            }
-
-            // Prefix increment to advance iterator
-            ReverseOrderIterator& operator++() {
-                if (index < 0) {
-                    return *this; // if already at end
-                }
-                
-                index--; 
-                
-                return *this;
-            }
-
-            // Inequality check
-            bool operator!=(const ReverseOrderIterator& other) const {
-                return index != other.index;
-            }
-
-            // Equality check
-            bool operator==(const ReverseOrderIterator& other) const {
-                return index == other.index;
-            }
-    };
+    using ReverseOrderIterator = PolicyIterator<orders::Reverse>;
 
     // Helper methods for begin/end of the iterator
     ReverseOrderIterator beginReverse() const {
-        return ReverseOrderIterator(*this);
+        return beginOf<orders::Reverse>();
     }
 
     ReverseOrderIterator endReverse() const {
-        return ReverseOrderIterator(*this, true);
+        return endOf<orders::Reverse>();
+    }
+
+    /**
+    * @brief The reverse-insertion traversal as a view.
+    */
+    auto reverse() const {
+        return view<orders::Reverse>();
     }
 
 
@@ -331,54 +1012,22 @@ namespace dael_containers {
      * @class Order
      * @brief Iterates through the container in the order elements were added.
      */
-    class OrderIterator{
-        private:
-            const MyContainer<T>& container;
-            size_t index;
-
-        public:
-            OrderIterator(const MyContainer<T>& cont, bool isEnd = false):container(cont),index(0){
-                if (isEnd || cont.size() == 0) {
-                    index = cont.size(); 
-                }
-            }
-
-            // Dereferencing to get current value
-            const T& operator*() const {
-                if (index >= container.data.size()) 
-                {
-                    throw std::out_of_range("Iterator out of bounds");
-                }
-                return container.data[index];
-            }
-
-            // Prefix increment to advance iterator
-            OrderIterator& operator++() {
-                if (index < container.data.size()) 
-                {
-                    ++index;
-                }
-                return *this;
-            }
-
-            // Inequality check
-            bool operator!=(const OrderIterator& other) const {
-                return index != other.index;
-            }
-
-            // Equality check
-            bool operator==(const OrderIterator& other) const {
-                return index == other.index;
-            }
-    };
+    using OrderIterator = PolicyIterator<orders::Order>;
 
     // Helper methods for begin/end of the iterator
     OrderIterator beginOrder() const {
-        return OrderIterator(*this);
+        return beginOf<orders::Order>();
     }
 
     OrderIterator endOrder() const {
-        return OrderIterator(*this, true);
+        return endOf<orders::Order>();
+    }
+
+    /**
+    * @brief The insertion-order traversal as a view.
+    */
+    auto order() const {
+        return view<orders::Order>();
     }
 
 //---------------------------MiddleOutOrderIterator-----------------------------------
@@ -387,102 +1036,248 @@ namespace dael_containers {
  * @class MiddleOutOrder
  * @brief Starts from the middle element and alternates between expanding left and right.
  */
-class MiddleOutOrderIterator {
-    private:
-        const MyContainer<T>& container;
-        std::vector<size_t> visitOrder; // The order in which to visit indices
-        size_t currentStep; // Current position in visitOrder
+    using MiddleOutOrderIterator = PolicyIterator<orders::MiddleOut>;
 
-         /**
-         * @brief Builds the visit order for the iterator starting from the middle index,
-         *        then alternating to the left and right.
-         * 
-         * For even-sized containers, the middle index is taken as floor(size / 2).
-         * Indices are added alternately: middle, left1, right1, left2, right2, ...
-         */
-        void buildVisitOrder() {
-            size_t size = container.size();
-            if (size == 0) return;
-            
-            // Find middle index (round down for even numbers)
-            size_t middleIndex = size / 2;
-            visitOrder.push_back(middleIndex);
-            
-            // Now alternate left and right from the middle
-            size_t leftOffset = 1;   // Distance to the left of middle
-            size_t rightOffset = 1;  // Distance to the right of middle
-            bool goLeft = true;      // Start with left
-            
-            while (visitOrder.size() < size) {
-                if (goLeft) {
-                    // Try to go left
-                    if (middleIndex >= leftOffset) {
-                        size_t leftIndex = middleIndex - leftOffset;
-                        visitOrder.push_back(leftIndex);
-                        leftOffset++;
-                    }
-                    goLeft = false; // Next time go right
-                } else {
-                    // Try to go right
-                    size_t rightIndex = middleIndex + rightOffset;
-                    if (rightIndex < size) {
-                        visitOrder.push_back(rightIndex);
-                        rightOffset++;
-                    }
-                    goLeft = true; // Next time go left
-                }
-            }
-        }
+     // Helper methods for begin/end of the iterator
+    MiddleOutOrderIterator beginMiddleOut() const {
+        return beginOf<orders::MiddleOut>();
+    }
 
-    public:
-        MiddleOutOrderIterator(const MyContainer<T>& cont, bool isEnd = false)
-            : container(cont), currentStep(0)
-        {
-            // Build the visit order: middle, then alternating left-right
-            if (cont.size() > 0) {
-                buildVisitOrder();
-            }
-            
-            if (isEnd) {
-                currentStep = visitOrder.size(); // Points to end
-            }
+     MiddleOutOrderIterator endMiddleOut() const {
+        return endOf<orders::MiddleOut>();
+    }
+
+    /**
+    * @brief The middle-out traversal as a view.
+    */
+    auto middleOut() const {
+        return view<orders::MiddleOut>();
+    }
+
+    //---------------------------Custom orderings-----------------------------------
+
+    /**
+    * @brief The elements in ascending order of compare(projection(a), projection(b)),
+    *        e.g. ascendingBy({}, &Person::age) or ascendingBy(std::greater<>()).
+    *        Each call sorts afresh (projections computed once per element); the
+    *        returned view owns its order and does not touch the cached sorted view.
+    */
+    template<typename Compare = std::ranges::less, typename Projection = std::identity>
+    std::ranges::subrange<AscendingOrderIterator> ascendingBy(Compare compare = {}, Projection projection = {}) const {
+        auto order = sortedViewBy(compare, projection);
+        return std::ranges::subrange(AscendingOrderIterator(*this, order), AscendingOrderIterator(*this, order, true));
+    }
+
+    /**
+    * @brief The reverse of ascendingBy(compare, projection).
+    */
+    template<typename Compare = std::ranges::less, typename Projection = std::identity>
+    std::ranges::subrange<DescendingOrderIterator> descendingBy(Compare compare = {}, Projection projection = {}) const {
+        auto order = sortedViewBy(compare, projection);
+        return std::ranges::subrange(DescendingOrderIterator(*this, order), DescendingOrderIterator(*this, order, true));
+    }
+
+    /**
+    * @brief The side-cross walk over ascendingBy(compare, projection).
+    */
+    template<typename Compare = std::ranges::less, typename Projection = std::identity>
+    std::ranges::subrange<SideCrossOrderIterator> sideCrossBy(Compare compare = {}, Projection projection = {}) const {
+        auto order = sortedViewBy(compare, projection);
+        return std::ranges::subrange(SideCrossOrderIterator(*this, order), SideCrossOrderIterator(*this, order, true));
+    }
+
+    //---------------------------Range queries-----------------------------------
+
+    /**
+    * @brief Ascending iterator at the first element not less than value (end if none).
+    *        O(log n) on the cached sorted view (built first if stale).
+    */
+    AscendingOrderIterator lowerBound(const T& value) const {
+        return beginAscending() + static_cast<std::ptrdiff_t>(countLessInView(value));
+    }
+
+    /**
+    * @brief Ascending iterator at the first element greater than value (end if none).
+    */
+    AscendingOrderIterator upperBound(const T& value) const {
+        return beginAscending() + static_cast<std::ptrdiff_t>(countLessOrEqualInView(value));
+    }
+
+    /**
+    * @brief The elements equal to value, as a view of the ascending order.
+    */
+    std::ranges::subrange<AscendingOrderIterator> equalRange(const T& value) const {
+        AscendingOrderIterator begin = beginAscending();
+        return std::ranges::subrange(begin + static_cast<std::ptrdiff_t>(countLessInView(value)),
+                                     begin + static_cast<std::ptrdiff_t>(countLessOrEqualInView(value)));
+    }
+
+    /**
+    * @brief Number of elements in [lo, hi). O(log n) with the order-statistic index,
+    *        otherwise two binary searches over the sorted view.
+    */
+    size_t countInRange(const T& lo, const T& hi) const {
+        if (!(lo < hi)) {
+            return 0;
         }
+        return countLess(hi) - countLess(lo);
+    }
 
-        // Dereferencing to get current value
-        const T& operator*() const {
-            if (currentStep >= visitOrder.size()) {
-                throw std::out_of_range("Iterator out of bounds");
-            }
-            size_t dataIndex = visitOrder[currentStep];
-            return container.data[dataIndex];
+    /**
+    * @brief The elements not less than value, smallest first.
+    */
+    std::ranges::subrange<AscendingOrderIterator> ascendingFrom(const T& value) const {
+        return std::ranges::subrange(lowerBound(value), endAscending());
+    }
+
+    /**
+    * @brief The elements not greater than value, largest first.
+    */
+    std::ranges::subrange<DescendingOrderIterator> descendingFrom(const T& value) const {
+        size_t greater = data.size() - countLessOrEqualInView(value);
+        return std::ranges::subrange(beginDescending() + static_cast<std::ptrdiff_t>(greater), endDescending());
+    }
+
+    //---------------------------Parallel traversal-----------------------------------
+
+    /**
+    * @brief Splits the traversal described by Policy (or named by Order) into parts
+    *        contiguous sub-ranges (sizes differ by at most one) that can be walked
+    *        concurrently. The value-ordered policies split over one shared sorted
+    *        view, the others by step ranges.
+    */
+    template<typename Policy>
+    auto split(size_t parts) const {
+        return detail::splitRange(view<Policy>(), parts);
+    }
+
+    template<IterationOrder Order>
+    auto split(size_t parts) const {
+        return split<typename PolicyFor<Order>::type>(parts);
+    }
+
+    /**
+    * @brief Calls fn(element) for every element, walking disjoint chunks of the
+    *        traversal on the shared thread pool. fn runs concurrently and in no
+    *        particular order across chunks; the container must not change meanwhile.
+    *
+    * Like every const method, this may be called from several threads at once on
+    * the same container (and fn may traverse it too): the sorted view is built
+    * once under a lock and then shared. Non-const methods (add(), remove(), ...)
+    * need exclusive access.
+    * @throws Rethrows the first exception thrown by fn.
+    */
+    template<typename Policy, typename Function>
+    void parallelForEach(Function fn) const {
+        detail::parallelForEach(view<Policy>(), fn);
+    }
+
+    template<typename Function>
+    void parallelForEach(IterationOrder order, Function fn) const {
+        withOrder(order, [this, &fn](auto policy) {
+            parallelForEach<typename decltype(policy)::type>(fn);
+        });
+    }
+
+    //---------------------------Block traversal-----------------------------------
+
+    /**
+    * @brief Calls fn(std::span<const T>) on consecutive blocks of blockSize elements
+    *        (the last one may be shorter) that together make up the traversal.
+    *
+    * Where the traversal is a forward walk over the storage (an identity policy:
+    * Order with InsertionOrderStorage, Ascending while the data is sorted or under
+    * SortedStorage) the spans point straight into the container. Other orders
+    * are gathered block by block into one reused buffer, so the spans are only
+    * valid until fn returns.
+    *
+    * @throws std::invalid_argument If blockSize is 0.
+    */
+    template<typename Policy, typename Function>
+    void forEachBlock(size_t blockSize, Function fn) const {
+        if (blockSize == 0) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        size_t size = data.size();
+        bool contiguous = false;
+        if constexpr (Policy::identity) {
+            contiguous = Policy::valueOrdered ? isDataSorted() : !keepsSorted;
         }
 
-        // Prefix increment to advance iterator
-        MiddleOutOrderIterator& operator++() {
-            if (currentStep < visitOrder.size()) {
-                currentStep++;
+        if (contiguous) {
+            for (size_t offset = 0; offset < size; offset += blockSize) {
+                fn(std::span<const T>(data.data() + offset, std::min(blockSize, size - offset)));
             }
-            return *this;
+            return;
         }
 
-        // Inequality check
-        bool operator!=(const MiddleOutOrderIterator& other) const {
-            return currentStep != other.currentStep;
+        auto begin = beginOf<Policy>();
+        std::vector<T> buffer;
+        buffer.reserve(std::min(blockSize, size));
+        for (size_t offset = 0; offset < size; offset += blockSize) {
+            auto first = begin + static_cast<std::ptrdiff_t>(offset);
+            buffer.assign(first, first + static_cast<std::ptrdiff_t>(std::min(blockSize, size - offset)));
+            fn(std::span<const T>(buffer));
         }
+    }
 
-        // Equality check
-        bool operator==(const MiddleOutOrderIterator& other) const {
-            return currentStep == other.currentStep;
-        }
-    };
+    template<typename Function>
+    void forEachBlock(IterationOrder order, size_t blockSize, Function fn) const {
+        withOrder(order, [this, blockSize, &fn](auto policy) {
+            forEachBlock<typename decltype(policy)::type>(blockSize, std::ref(fn));
+        });
+    }
 
-     // Helper methods for begin/end of the iterator
-    MiddleOutOrderIterator beginMiddleOut() const {
-        return MiddleOutOrderIterator(*this);
+    //---------------------------Generator traversal-----------------------------------
+
+    /**
+    * @brief The traversal described by Policy (or named by order) as a coroutine
+    *        generator (an input view) that produces one element per resumption,
+    *        for consumers that pull elements across suspension points.
+    *
+    * The generator holds iterators, not a copy of the elements: the sorted orders
+    * share the container's sorted view, Order, Reverse and MiddleOut need O(1)
+    * extra memory, and with TraversalMode::Lazy the value-ordered ones extract
+    * elements from a heap only as they are pulled. The container must outlive
+    * the generator and not change while it is in use.
+    */
+    template<typename Policy>
+    Generator<T> generate(TraversalMode mode = TraversalMode::Snapshot) const {
+        return yieldAll(view<Policy>(mode));
     }
 
-     MiddleOutOrderIterator endMiddleOut() const {
-        return MiddleOutOrderIterator(*this, true);
+    Generator<T> generate(IterationOrder order, TraversalMode mode = TraversalMode::Snapshot) const {
+        return withOrder(order, [this, mode](auto policy) {
+            return generate<typename decltype(policy)::type>(mode);
+        });
+    }
+
+    private:
+    // Calls visitor with std::type_identity<Policy> for the policy of order, turning the runtime order into a template argument
+    template<typename Visitor>
+    decltype(auto) withOrder(IterationOrder order, Visitor&& visitor) const {
+        switch (order) {
+            case IterationOrder::Ascending:
+                return visitor(std::type_identity<orders::Ascending>{});
+            case IterationOrder::Descending:
+                return visitor(std::type_identity<orders::Descending>{});
+            case IterationOrder::SideCross:
+                return visitor(std::type_identity<orders::SideCross>{});
+            case IterationOrder::Reverse:
+                return visitor(std::type_identity<orders::Reverse>{});
+            case IterationOrder::Order:
+                return visitor(std::type_identity<orders::Order>{});
+            default:
+                return visitor(std::type_identity<orders::MiddleOut>{});
+        }
+    }
+
+    // The coroutine behind generate(): owns the range (and so the view it shares) for its lifetime
+    template<typename Range>
+    static Generator<T> yieldAll(Range range) {
+        for (const T& value : range) {
+            co_yield value;
+        }
     }
     
 
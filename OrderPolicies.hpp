@@ -0,0 +1,187 @@
+//dael12345@gmail.com
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <utility>
+#include "LazySelection.hpp"
+
+namespace dael_containers {
+
+    /**
+     * @brief Names the six traversal orders, for the APIs that take the order as a parameter.
+     */
+    enum class IterationOrder {
+        Ascending,
+        Descending,
+        SideCross,
+        Reverse,
+        Order,
+        MiddleOut
+    };
+
+/**
+ * @brief Iteration-order policies.
+ *
+ * An order is a stateless struct; MyContainer generates the iterator,
+ * begin/end, view, split, block and generator access for it
+ * (MyContainer::PolicyIterator<Policy>, beginOf<Policy>(), view<Policy>(), ...).
+ * A policy provides:
+ *  - static constexpr bool valueOrdered: map() yields ranks of the container's
+ *    sorted view (true) or positions in insertion order (false);
+ *  - static constexpr bool identity: map(step, size) == step, which lets
+ *    forEachBlock() hand out spans straight into the storage when it can;
+ *  - static constexpr size_t map(size_t step, size_t size): the rank or position
+ *    visited at step, a bijection on [0, size);
+ *  - optionally template<typename T> static auto makeLazy(const std::vector<T>&):
+ *    a shared lazy index whose at(step) returns the data index visited at step,
+ *    used by TraversalMode::Lazy instead of the sorted view.
+ */
+namespace orders {
+
+    /**
+     * @brief Smallest to largest element.
+     */
+    struct Ascending {
+        static constexpr bool valueOrdered = true;
+        static constexpr bool identity = true;
+
+        static constexpr size_t map(size_t step, size_t) {
+            return step;
+        }
+
+        template<typename T>
+        static auto makeLazy(const std::vector<T>& data) {
+            return std::make_shared<detail::LazySortedIndex<T>>(data, false);
+        }
+    };
+
+    /**
+     * @brief Largest to smallest element.
+     */
+    struct Descending {
+        static constexpr bool valueOrdered = true;
+        static constexpr bool identity = false;
+
+        static constexpr size_t map(size_t step, size_t size) {
+            return size - 1 - step;
+        }
+
+        template<typename T>
+        static auto makeLazy(const std::vector<T>& data) {
+            // The lazy index produces largest first, so it is walked from the front
+            return std::make_shared<detail::LazySortedIndex<T>>(data, true);
+        }
+    };
+
+    /**
+     * @brief Alternates between the smallest and largest remaining elements.
+     */
+    struct SideCross {
+        static constexpr bool valueOrdered = true;
+        static constexpr bool identity = false;
+
+        // Even steps take from the left side of the sorted order, odd steps from the right
+        static constexpr size_t map(size_t step, size_t size) {
+            return step % 2 == 0 ? step / 2 : size - 1 - step / 2;
+        }
+
+        template<typename T>
+        static auto makeLazy(const std::vector<T>& data) {
+            return std::make_shared<detail::LazySideCrossIndex<T>>(data);
+        }
+    };
+
+    /**
+     * @brief Reverse of insertion order.
+     */
+    struct Reverse {
+        static constexpr bool valueOrdered = false;
+        static constexpr bool identity = false;
+
+        static constexpr size_t map(size_t step, size_t size) {
+            return size - 1 - step;
+        }
+    };
+
+    /**
+     * @brief The order elements were added in.
+     */
+    struct Order {
+        static constexpr bool valueOrdered = false;
+        static constexpr bool identity = true;
+
+        static constexpr size_t map(size_t step, size_t) {
+            return step;
+        }
+    };
+
+    /**
+     * @brief Starts from the middle element and alternates between expanding left and right.
+     */
+    struct MiddleOut {
+        static constexpr bool valueOrdered = false;
+        static constexpr bool identity = false;
+
+        /**
+         * For even-sized containers, the middle index is taken as floor(size / 2).
+         * Indices are visited alternately: middle, left1, right1, left2, right2, ...
+         * The left side is never shorter than the right one, so the pattern has no
+         * gaps and step s lands at distance (s + 1) / 2 from the middle.
+         */
+        static constexpr size_t map(size_t step, size_t size) {
+            size_t middleIndex = size / 2;
+            size_t offset = (step + 1) / 2;
+            return step % 2 == 1 ? middleIndex - offset : middleIndex + offset;
+        }
+    };
+
+}
+
+    /**
+     * @brief True if Policy supports TraversalMode::Lazy for elements of type T.
+     */
+    template<typename Policy, typename T>
+    concept LazyOrderPolicy = requires(const std::vector<T>& data) {
+        Policy::makeLazy(data)->at(size_t{0});
+    };
+
+namespace detail {
+
+    // What an iterator keeps of the sorted view (or, under SortedStorage, of the insertion-order view)
+    struct SortedViewHandle {
+        mutable std::shared_ptr<const std::vector<size_t>> sortedIndex;  // Shared view, null when data is already in that order
+        mutable bool resolved = false;  // End iterators fetch the view only if dereferenced
+    };
+
+    // Stand-ins that take no space in iterators of policies without a sorted view or a lazy mode
+    struct NoSortedView {};
+    struct NoLazyIndex {};
+
+    template<typename Policy, typename T>
+    struct LazyIndexOf {
+        using type = NoLazyIndex;
+    };
+
+    template<typename Policy, typename T>
+        requires LazyOrderPolicy<Policy, T>
+    struct LazyIndexOf<Policy, T> {
+        using type = decltype(Policy::makeLazy(std::declval<const std::vector<T>&>()));
+    };
+
+}
+
+    /**
+     * @brief Maps an IterationOrder to its policy type.
+     */
+    template<IterationOrder Order>
+    struct PolicyFor;
+
+    template<> struct PolicyFor<IterationOrder::Ascending> { using type = orders::Ascending; };
+    template<> struct PolicyFor<IterationOrder::Descending> { using type = orders::Descending; };
+    template<> struct PolicyFor<IterationOrder::SideCross> { using type = orders::SideCross; };
+    template<> struct PolicyFor<IterationOrder::Reverse> { using type = orders::Reverse; };
+    template<> struct PolicyFor<IterationOrder::Order> { using type = orders::Order; };
+    template<> struct PolicyFor<IterationOrder::MiddleOut> { using type = orders::MiddleOut; };
+
+}
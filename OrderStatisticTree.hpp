@@ -0,0 +1,407 @@
+//dael12345@gmail.com
+#pragma once
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace dael_containers {
+
+    /**
+     * @class OrderStatisticTree
+     * @brief A counted B+-tree over a multiset of T: every inner node knows how many
+     *        elements each child subtree holds, so rank and select are O(log n).
+     *
+     * Leaves store up to leafCapacity sorted values contiguously and are chained
+     * for in-order iteration; inner nodes store the minimum value and the element
+     * count of each child. Inserting and erasing are O(log n). Erasing does not
+     * merge underfull nodes; empty nodes are freed, and the tree is rebuilt
+     * densely once it shrinks to a quarter of its peak size, which keeps the
+     * height logarithmic in the current size (amortized).
+     *
+     * @tparam T The element type. Must be comparable with operator<.
+     */
+    template<typename T>
+    class OrderStatisticTree {
+    private:
+        static constexpr size_t leafCapacity = 64;
+        static constexpr size_t innerCapacity = 32;
+
+        struct Node {
+            explicit Node(bool isLeaf) : leaf(isLeaf) {}
+            virtual ~Node() = default;
+            bool leaf;
+            size_t count = 0;  // Elements in this subtree
+        };
+
+        struct Leaf : Node {
+            Leaf() : Node(true) { values.reserve(leafCapacity + 1); }
+            std::vector<T> values;
+            Leaf* prev = nullptr;
+            Leaf* next = nullptr;
+        };
+
+        struct Inner : Node {
+            Inner() : Node(false) {}
+            std::vector<std::unique_ptr<Node>> children;
+            std::vector<T> mins;  // mins[i] is the smallest value in children[i]
+        };
+
+        std::unique_ptr<Node> root;
+        Leaf* firstLeaf = nullptr;
+        size_t peak = 0;  // Largest size since the last rebuild
+
+        static const T& minOf(const Node* node) {
+            return node->leaf ? static_cast<const Leaf*>(node)->values.front()
+                              : static_cast<const Inner*>(node)->mins.front();
+        }
+
+        // Index of the last child whose minimum is below value (strict) or not above it (!strict); 0 if none
+        static size_t childFor(const Inner* inner, const T& value, bool strict) {
+            auto it = strict ? std::lower_bound(inner->mins.begin(), inner->mins.end(), value)
+                             : std::upper_bound(inner->mins.begin(), inner->mins.end(), value);
+            return it == inner->mins.begin() ? 0 : static_cast<size_t>(it - inner->mins.begin()) - 1;
+        }
+
+        // Inserts into the subtree; returns the new right sibling if the node had to split
+        std::unique_ptr<Node> insertInto(Node* node, const T& value) {
+            ++node->count;
+            if (node->leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                leaf->values.insert(std::upper_bound(leaf->values.begin(), leaf->values.end(), value), value);
+                if (leaf->values.size() <= leafCapacity) {
+                    return nullptr;
+                }
+                auto sibling = std::make_unique<Leaf>();
+                size_t half = leaf->values.size() / 2;
+                sibling->values.assign(leaf->values.begin() + static_cast<std::ptrdiff_t>(half), leaf->values.end());
+                leaf->values.erase(leaf->values.begin() + static_cast<std::ptrdiff_t>(half), leaf->values.end());
+                sibling->count = sibling->values.size();
+                leaf->count = half;
+                sibling->next = leaf->next;
+                sibling->prev = leaf;
+                if (leaf->next) {
+                    leaf->next->prev = sibling.get();
+                }
+                leaf->next = sibling.get();
+                return sibling;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            size_t i = childFor(inner, value, false);
+            auto split = insertInto(inner->children[i].get(), value);
+            inner->mins[i] = minOf(inner->children[i].get());
+            if (split) {
+                inner->mins.insert(inner->mins.begin() + static_cast<std::ptrdiff_t>(i + 1), minOf(split.get()));
+                inner->children.insert(inner->children.begin() + static_cast<std::ptrdiff_t>(i + 1), std::move(split));
+            }
+            if (inner->children.size() <= innerCapacity) {
+                return nullptr;
+            }
+            auto sibling = std::make_unique<Inner>();
+            size_t half = inner->children.size() / 2;
+            for (size_t c = half; c < inner->children.size(); ++c) {
+                sibling->count += inner->children[c]->count;
+                sibling->children.push_back(std::move(inner->children[c]));
+                sibling->mins.push_back(inner->mins[c]);
+            }
+            inner->children.erase(inner->children.begin() + static_cast<std::ptrdiff_t>(half), inner->children.end());
+            inner->mins.erase(inner->mins.begin() + static_cast<std::ptrdiff_t>(half), inner->mins.end());
+            inner->count -= sibling->count;
+            return sibling;
+        }
+
+        // Erases the element at rank within the subtree; returns true if the node became empty
+        bool eraseFrom(Node* node, size_t rank) {
+            --node->count;
+            if (node->leaf) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                leaf->values.erase(leaf->values.begin() + static_cast<std::ptrdiff_t>(rank));
+                if (!leaf->values.empty()) {
+                    return false;
+                }
+                if (leaf->prev) {
+                    leaf->prev->next = leaf->next;
+                } else {
+                    firstLeaf = leaf->next;
+                }
+                if (leaf->next) {
+                    leaf->next->prev = leaf->prev;
+                }
+                return true;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            size_t i = 0;
+            while (rank >= inner->children[i]->count) {
+                rank -= inner->children[i]->count;
+                ++i;
+            }
+            if (eraseFrom(inner->children[i].get(), rank)) {
+                inner->children.erase(inner->children.begin() + static_cast<std::ptrdiff_t>(i));
+                inner->mins.erase(inner->mins.begin() + static_cast<std::ptrdiff_t>(i));
+            } else {
+                inner->mins[i] = minOf(inner->children[i].get());
+            }
+            return inner->children.empty();
+        }
+
+        // Elements below value (strict) or not above it (!strict)
+        size_t countBelow(const T& value, bool strict) const {
+            size_t result = 0;
+            const Node* node = root.get();
+            while (node && !node->leaf) {
+                const Inner* inner = static_cast<const Inner*>(node);
+                size_t i = childFor(inner, value, strict);
+                for (size_t c = 0; c < i; ++c) {
+                    result += inner->children[c]->count;
+                }
+                node = inner->children[i].get();
+            }
+            if (node) {
+                const auto& values = static_cast<const Leaf*>(node)->values;
+                auto it = strict ? std::lower_bound(values.begin(), values.end(), value)
+                                 : std::upper_bound(values.begin(), values.end(), value);
+                result += static_cast<size_t>(it - values.begin());
+            }
+            return result;
+        }
+
+        // Builds a dense tree from sorted values in O(n)
+        void build(const std::vector<T>& sorted) {
+            root.reset();
+            firstLeaf = nullptr;
+            peak = sorted.size();
+            if (sorted.empty()) {
+                return;
+            }
+
+            const size_t leafFill = leafCapacity * 3 / 4;  // Leave room so the next inserts do not split at once
+            std::vector<std::unique_ptr<Node>> level;
+            Leaf* previous = nullptr;
+            for (size_t start = 0; start < sorted.size(); start += leafFill) {
+                auto leaf = std::make_unique<Leaf>();
+                size_t end = std::min(sorted.size(), start + leafFill);
+                leaf->values.assign(sorted.begin() + static_cast<std::ptrdiff_t>(start),
+                                    sorted.begin() + static_cast<std::ptrdiff_t>(end));
+                leaf->count = end - start;
+                leaf->prev = previous;
+                if (previous) {
+                    previous->next = leaf.get();
+                } else {
+                    firstLeaf = leaf.get();
+                }
+                previous = leaf.get();
+                level.push_back(std::move(leaf));
+            }
+
+            const size_t innerFill = innerCapacity * 3 / 4;
+            while (level.size() > 1) {
+                std::vector<std::unique_ptr<Node>> parents;
+                for (size_t start = 0; start < level.size(); start += innerFill) {
+                    auto inner = std::make_unique<Inner>();
+                    for (size_t c = start; c < std::min(level.size(), start + innerFill); ++c) {
+                        inner->count += level[c]->count;
+                        inner->mins.push_back(minOf(level[c].get()));
+                        inner->children.push_back(std::move(level[c]));
+                    }
+                    parents.push_back(std::move(inner));
+                }
+                level.swap(parents);
+            }
+            root = std::move(level.front());
+        }
+
+    public:
+        /**
+         * @class Iterator
+         * @brief Walks the tree in ascending order along the leaf chain.
+         */
+        class Iterator {
+        private:
+            const Leaf* leaf;
+            size_t pos;
+
+        public:
+            Iterator(const Leaf* start = nullptr, size_t position = 0) : leaf(start), pos(position) {}
+
+            // Dereferencing to get current value
+            const T& operator*() const {
+                if (!leaf) {
+                    throw std::out_of_range("Iterator out of bounds");
+                }
+                return leaf->values[pos];
+            }
+
+            // Prefix increment to advance iterator
+            Iterator& operator++() {
+                if (leaf && ++pos == leaf->values.size()) {
+                    leaf = leaf->next;
+                    pos = 0;
+                }
+                return *this;
+            }
+
+            // Inequality check
+            bool operator!=(const Iterator& other) const {
+                return leaf != other.leaf || pos != other.pos;
+            }
+
+            // Equality check
+            bool operator==(const Iterator& other) const {
+                return !(*this != other);
+            }
+        };
+
+        OrderStatisticTree() = default;
+
+        /**
+         * @brief Builds the tree from values already sorted in ascending order, in O(n).
+         */
+        explicit OrderStatisticTree(const std::vector<T>& sorted) {
+            build(sorted);
+        }
+
+        OrderStatisticTree(const OrderStatisticTree& other) {
+            build(other.toVector());
+        }
+
+        OrderStatisticTree(OrderStatisticTree&& other) noexcept
+            : root(std::move(other.root)), firstLeaf(std::exchange(other.firstLeaf, nullptr)),
+              peak(std::exchange(other.peak, 0))
+        {
+        }
+
+        OrderStatisticTree& operator=(OrderStatisticTree other) noexcept {
+            std::swap(root, other.root);
+            std::swap(firstLeaf, other.firstLeaf);
+            std::swap(peak, other.peak);
+            return *this;
+        }
+
+        size_t size() const {
+            return root ? root->count : 0;
+        }
+
+        /**
+         * @brief Adds one occurrence of value. O(log n).
+         */
+        void insert(const T& value) {
+            if (!root) {
+                auto leaf = std::make_unique<Leaf>();
+                firstLeaf = leaf.get();
+                root = std::move(leaf);
+            }
+            auto split = insertInto(root.get(), value);
+            if (split) {
+                auto newRoot = std::make_unique<Inner>();
+                newRoot->count = root->count + split->count;
+                newRoot->mins.push_back(minOf(root.get()));
+                newRoot->mins.push_back(minOf(split.get()));
+                newRoot->children.push_back(std::move(root));
+                newRoot->children.push_back(std::move(split));
+                root = std::move(newRoot);
+            }
+            peak = std::max(peak, size());
+        }
+
+        /**
+         * @brief Removes every occurrence of value. O(log n) per removed element.
+         * @return How many elements were removed.
+         */
+        size_t eraseAll(const T& value) {
+            size_t first = countLess(value);
+            size_t removed = countLessOrEqual(value) - first;
+            for (size_t i = 0; i < removed; ++i) {
+                if (eraseFrom(root.get(), first)) {
+                    root.reset();
+                }
+            }
+            // Collapse single-child roots left behind by erasing
+            while (root && !root->leaf && static_cast<Inner*>(root.get())->children.size() == 1) {
+                root = std::move(static_cast<Inner*>(root.get())->children.front());
+            }
+            if (size() * 4 < peak) {
+                build(toVector());
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Returns the element of rank k (0 is the smallest). O(log n).
+         * @throws std::out_of_range If k >= size().
+         */
+        const T& select(size_t k) const {
+            if (k >= size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            const Node* node = root.get();
+            while (!node->leaf) {
+                const Inner* inner = static_cast<const Inner*>(node);
+                size_t i = 0;
+                while (k >= inner->children[i]->count) {
+                    k -= inner->children[i]->count;
+                    ++i;
+                }
+                node = inner->children[i].get();
+            }
+            return static_cast<const Leaf*>(node)->values[k];
+        }
+
+        /**
+         * @brief Number of elements strictly smaller than value. O(log n).
+         */
+        size_t countLess(const T& value) const {
+            return countBelow(value, true);
+        }
+
+        /**
+         * @brief Number of elements smaller than or equal to value. O(log n).
+         */
+        size_t countLessOrEqual(const T& value) const {
+            return countBelow(value, false);
+        }
+
+        /**
+         * @brief Iterator to the first element not smaller than value. O(log n).
+         */
+        Iterator lowerBound(const T& value) const {
+            const Node* node = root.get();
+            if (!node) {
+                return end();
+            }
+            while (!node->leaf) {
+                const Inner* inner = static_cast<const Inner*>(node);
+                node = inner->children[childFor(inner, value, true)].get();
+            }
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            size_t pos = static_cast<size_t>(std::lower_bound(leaf->values.begin(), leaf->values.end(), value) - leaf->values.begin());
+            if (pos == leaf->values.size()) {
+                return Iterator(leaf->next, 0);  // Everything from the next leaf on is >= value
+            }
+            return Iterator(leaf, pos);
+        }
+
+        Iterator begin() const {
+            return Iterator(firstLeaf, 0);
+        }
+
+        Iterator end() const {
+            return Iterator();
+        }
+
+        /**
+         * @brief Copies all elements in ascending order.
+         */
+        std::vector<T> toVector() const {
+            std::vector<T> values;
+            values.reserve(size());
+            for (const Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+                values.insert(values.end(), leaf->values.begin(), leaf->values.end());
+            }
+            return values;
+        }
+    };
+
+}
@@ -0,0 +1,73 @@
+//dael12345@gmail.com
+#pragma once
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <functional>
+#include "ThreadPool.hpp"
+
+namespace dael_containers {
+
+namespace detail {
+
+    /**
+     * @brief Smallest number of elements worth handing to a thread of its own.
+     */
+    inline constexpr size_t parallelTraversalGrain = size_t{1} << 14;
+
+    /**
+     * @brief Splits a random-access range into parts contiguous sub-ranges whose
+     *        sizes differ by at most one. Every sub-range is derived from the
+     *        range's begin iterator, so they all share whatever state it holds
+     *        (e.g. the sorted view) and none of them builds anything new.
+     * @param parts Number of sub-ranges (at least 1; empty sub-ranges are possible
+     *              when the range has fewer elements).
+     */
+    template<std::ranges::random_access_range Range>
+    auto splitRange(const Range& range, size_t parts) {
+        using Iterator = std::ranges::iterator_t<const Range>;
+        parts = std::max<size_t>(parts, 1);
+        size_t length = static_cast<size_t>(std::ranges::distance(range));
+        Iterator begin = std::ranges::begin(range);
+
+        std::vector<std::ranges::subrange<Iterator>> result;
+        result.reserve(parts);
+        size_t offset = 0;
+        for (size_t part = 0; part < parts; ++part) {
+            size_t partLength = length / parts + (part < length % parts ? 1 : 0);
+            Iterator first = begin + static_cast<std::ptrdiff_t>(offset);
+            result.emplace_back(first, first + static_cast<std::ptrdiff_t>(partLength));
+            offset += partLength;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls fn on every element of a random-access range, splitting it
+     *        into one chunk per thread of the shared pool (the caller included).
+     *        Ranges too short to be worth splitting run on the calling thread.
+     * @throws Rethrows the first exception thrown by fn, after all chunks finished.
+     */
+    template<std::ranges::random_access_range Range, typename Function>
+    void parallelForEach(const Range& range, Function& fn) {
+        ThreadPool& pool = sharedThreadPool();
+        size_t length = static_cast<size_t>(std::ranges::distance(range));
+        size_t parts = std::min(pool.size() + 1, std::max<size_t>(length / parallelTraversalGrain, 1));
+        if (parts == 1) {
+            for (const auto& value : range) {
+                fn(value);
+            }
+            return;
+        }
+
+        auto chunks = splitRange(range, parts);
+        pool.parallelFor(chunks.size(), [&chunks, &fn](size_t chunk) {
+            for (const auto& value : chunks[chunk]) {
+                fn(value);
+            }
+        });
+    }
+
+}
+
+}
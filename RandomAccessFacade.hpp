@@ -0,0 +1,131 @@
+//dael12345@gmail.com
+#pragma once
+#include <cstddef>
+#include <iterator>
+
+namespace dael_containers {
+
+namespace detail {
+
+    /**
+     * @class RandomAccessFacade
+     * @brief Supplies the random-access iterator interface on top of a position.
+     *
+     * Derived keeps a traversal position (0 for the first element, size for end)
+     * and implements position(), advance(n) and operator*(). Everything else a
+     * standard random-access iterator needs (postfix forms, jumps, distances,
+     * subscript, ordering) is written here once for all iterator classes.
+     *
+     * Iterators compare by position only, so they must come from the same container.
+     *
+     * @tparam Derived The iterator class (CRTP).
+     * @tparam T The element type.
+     */
+    template<typename Derived, typename T>
+    class RandomAccessFacade {
+    private:
+        Derived& self() {
+            return static_cast<Derived&>(*this);
+        }
+
+        const Derived& self() const {
+            return static_cast<const Derived&>(*this);
+        }
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        pointer operator->() const {
+            return &*self();
+        }
+
+        reference operator[](difference_type n) const {
+            return *(self() + n);
+        }
+
+        // Prefix increment to advance iterator
+        Derived& operator++() {
+            self().advance(1);
+            return self();
+        }
+
+        Derived operator++(int) {
+            Derived previous = self();
+            self().advance(1);
+            return previous;
+        }
+
+        Derived& operator--() {
+            self().advance(-1);
+            return self();
+        }
+
+        Derived operator--(int) {
+            Derived previous = self();
+            self().advance(-1);
+            return previous;
+        }
+
+        Derived& operator+=(difference_type n) {
+            self().advance(n);
+            return self();
+        }
+
+        Derived& operator-=(difference_type n) {
+            self().advance(-n);
+            return self();
+        }
+
+        friend Derived operator+(Derived it, difference_type n) {
+            it.advance(n);
+            return it;
+        }
+
+        friend Derived operator+(difference_type n, Derived it) {
+            it.advance(n);
+            return it;
+        }
+
+        friend Derived operator-(Derived it, difference_type n) {
+            it.advance(-n);
+            return it;
+        }
+
+        friend difference_type operator-(const Derived& a, const Derived& b) {
+            return a.position() - b.position();
+        }
+
+        // Equality check
+        friend bool operator==(const Derived& a, const Derived& b) {
+            return a.position() == b.position();
+        }
+
+        // Inequality check
+        friend bool operator!=(const Derived& a, const Derived& b) {
+            return a.position() != b.position();
+        }
+
+        friend bool operator<(const Derived& a, const Derived& b) {
+            return a.position() < b.position();
+        }
+
+        friend bool operator>(const Derived& a, const Derived& b) {
+            return a.position() > b.position();
+        }
+
+        friend bool operator<=(const Derived& a, const Derived& b) {
+            return a.position() <= b.position();
+        }
+
+        friend bool operator>=(const Derived& a, const Derived& b) {
+            return a.position() >= b.position();
+        }
+    };
+
+}
+
+}
@@ -0,0 +1,117 @@
+//dael12345@gmail.com
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace dael_containers {
+
+namespace detail {
+
+    /**
+     * @brief Branchless binary search: returns how many of the positions 0 ... n - 1
+     *        satisfy before(i), given that before holds for a prefix of them.
+     *
+     * Every step halves the interval without a data-dependent branch (the
+     * comparison result feeds a conditional move), so the loop runs exactly
+     * ceil(log2 n) + 1 times and never mispredicts. Meant for cheap comparisons
+     * such as arithmetic keys.
+     *
+     * @param before Called with a position, true while that position comes before the answer.
+     */
+    template<typename Before>
+    size_t branchlessPartitionPoint(size_t n, Before before) {
+        if (n == 0) {
+            return 0;
+        }
+        size_t base = 0;
+        while (n > 1) {
+            size_t half = n / 2;
+            base = before(base + half) ? base + half : base;
+            n -= half;
+        }
+        return base + (before(base) ? 1 : 0);
+    }
+
+    /**
+     * @class EytzingerIndex
+     * @brief Copy of a sorted sequence in Eytzinger (BFS) order, for cache-friendly search.
+     *
+     * Node k has its children at 2k and 2k + 1 (1-based), so the first levels of
+     * every search share a few cache lines, and the 2^4 descendants four levels
+     * down a node sit next to each other and can be prefetched while the current
+     * comparisons run. A plain binary search instead touches a new cache line at
+     * every step of a large array. ranks[k] maps a node back to its position in
+     * the sorted sequence.
+     *
+     * @tparam T The element type.
+     */
+    template<typename T>
+    class EytzingerIndex {
+    private:
+        std::vector<T> keys;         // Node k (1-based, BFS order) at keys[k - 1]
+        std::vector<size_t> ranks;   // Sorted position of node k, ranks[0] unused
+        size_t generation = 0;       // Container generation the index was built for
+        bool built = false;
+
+        // The 16 descendants four levels down are contiguous: one cache line of 4-byte keys
+        static constexpr size_t prefetchStride = 16;
+
+        void fillRanks(size_t node, size_t& nextRank) {
+            // In-order walk of the implicit tree hands out ranks in ascending order
+            if (node >= ranks.size()) {
+                return;
+            }
+            fillRanks(2 * node, nextRank);
+            ranks[node] = nextRank++;
+            fillRanks(2 * node + 1, nextRank);
+        }
+
+    public:
+        /**
+         * @brief True if the index was built for this generation of the container.
+         */
+        bool isFreshFor(size_t containerGeneration) const {
+            return built && generation == containerGeneration;
+        }
+
+        /**
+         * @brief Rebuilds the index from n sorted elements in O(n). Keys are appended
+         *        in node order, so T needs no default constructor.
+         * @param valueAtRank Returns the element at a given sorted position.
+         */
+        template<typename ValueAtRank>
+        void rebuild(size_t containerGeneration, size_t n, const ValueAtRank& valueAtRank) {
+            ranks.assign(n + 1, n);
+            size_t nextRank = 0;
+            fillRanks(1, nextRank);
+            keys.clear();
+            keys.reserve(n);
+            for (size_t node = 1; node <= n; ++node) {
+                keys.push_back(valueAtRank(ranks[node]));
+            }
+            generation = containerGeneration;
+            built = true;
+        }
+
+        /**
+         * @brief Returns how many elements satisfy before (which must hold for a prefix
+         *        of the sorted sequence), like detail::branchlessPartitionPoint().
+         */
+        template<typename Before>
+        size_t partitionPoint(Before before) const {
+            size_t n = keys.size();
+            size_t node = 1;
+            while (node <= n) {
+                __builtin_prefetch(keys.data() + std::min(node * prefetchStride, n) - 1);
+                node = 2 * node + (before(keys[node - 1]) ? 1 : 0);
+            }
+            // The answer is the last node where the search went left: drop the trailing right turns and that left turn
+            node >>= __builtin_ctzll(~static_cast<unsigned long long>(node)) + 1;
+            return node == 0 ? n : ranks[node];
+        }
+    };
+
+}
+
+}
@@ -0,0 +1,484 @@
+//dael12345@gmail.com
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "ThreadPool.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define DAEL_CONTAINERS_AVX2_SORT 1
+#endif
+
+namespace dael_containers {
+
+namespace detail {
+
+    /**
+     * @brief Maps element types whose order matches the order of an unsigned integer
+     *        key of the same width. Only these types get the radix sort kernel.
+     *
+     * Integral types (except bool) and IEEE-754 float/double qualify.
+     */
+    template<typename T, typename = void>
+    struct RadixKey {
+        static constexpr bool supported = false;
+    };
+
+    template<typename T>
+    struct RadixKey<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+        static constexpr bool supported = true;
+        using type = std::make_unsigned_t<T>;
+
+        static type encode(T value) {
+            type bits = static_cast<type>(value);
+            if (std::is_signed<T>::value) {
+                bits ^= type(1) << (sizeof(T) * 8 - 1);  // Negative numbers sort before positive ones
+            }
+            return bits;
+        }
+    };
+
+    template<typename T>
+    struct RadixKey<T, std::enable_if_t<std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559
+                                        && (sizeof(T) == 4 || sizeof(T) == 8)>> {
+        static constexpr bool supported = true;
+        using type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+        static type encode(T value) {
+            type bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            // Sign-flip transform: negatives get all bits inverted, positives just the sign bit
+            const type signBit = type(1) << (sizeof(T) * 8 - 1);
+            return (bits & signBit) ? static_cast<type>(~bits) : static_cast<type>(bits | signBit);
+        }
+    };
+
+    // Below these sizes the fixed per-pass cost of radix sort does not pay off against
+    // std::sort on fresh random data (bench.cpp index sort benchmark). 64-bit keys need
+    // twice as many passes as 32-bit ones and break even later.
+    constexpr size_t radixSortThreshold = 64;
+    constexpr size_t wideKeyRadixThreshold = 128;
+
+    /**
+     * @brief LSD radix sort of index by the radix keys of data[index[i]], one byte per pass.
+     *
+     * Passes in which every key shares the same byte are skipped, so e.g. small
+     * non-negative ints only pay for the bytes that actually differ.
+     */
+    template<typename T>
+    void radixSortIndex(const std::vector<T>& data, std::vector<size_t>& index) {
+        using Key = typename RadixKey<T>::type;
+        constexpr size_t passes = sizeof(Key);
+        const size_t n = index.size();
+
+        std::vector<Key> keys(n);
+        std::vector<size_t> counts(passes * 256, 0);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = RadixKey<T>::encode(data[index[i]]);
+            for (size_t pass = 0; pass < passes; ++pass) {
+                ++counts[pass * 256 + ((keys[i] >> (pass * 8)) & 0xFF)];
+            }
+        }
+
+        std::vector<Key> keysOut(n);
+        std::vector<size_t> indexOut(n);
+        for (size_t pass = 0; pass < passes; ++pass) {
+            size_t* count = &counts[pass * 256];
+            if (std::find(count, count + 256, n) != count + 256) {
+                continue;  // All keys share this byte, the pass would not move anything
+            }
+
+            size_t offset = 0;
+            for (size_t bucket = 0; bucket < 256; ++bucket) {
+                size_t bucketSize = count[bucket];
+                count[bucket] = offset;
+                offset += bucketSize;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                size_t dest = count[(keys[i] >> (pass * 8)) & 0xFF]++;
+                keysOut[dest] = keys[i];
+                indexOut[dest] = index[i];
+            }
+            keys.swap(keysOut);
+            index.swap(indexOut);
+        }
+    }
+
+#ifdef DAEL_CONTAINERS_AVX2_SORT
+
+    /**
+     * @brief AVX2 sorting-network kernels on (int64 key, uint64 payload) pairs.
+     *
+     * A register holds four keys, a second register the matching payloads; every
+     * compare-exchange computes one mask from the keys and applies it to both.
+     * Blocks of 16 pairs are sorted into runs of 4 with a column network plus a
+     * transpose, then runs are merged with a vectorized bitonic merge.
+     * Only call these after avx2Supported() returned true.
+     */
+    namespace avx2 {
+
+        struct Pairs {
+            __m256i keys;
+            __m256i vals;
+        };
+
+        __attribute__((target("avx2"))) inline Pairs load(const std::int64_t* keys, const std::uint64_t* vals) {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals))};
+        }
+
+        __attribute__((target("avx2"))) inline void store(std::int64_t* keys, std::uint64_t* vals, const Pairs& p) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys), p.keys);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(vals), p.vals);
+        }
+
+        // Lane-wise compare-exchange: a receives the minima, b the maxima
+        __attribute__((target("avx2"))) inline void compareExchange(Pairs& a, Pairs& b) {
+            __m256i greater = _mm256_cmpgt_epi64(a.keys, b.keys);
+            Pairs lo = {_mm256_blendv_epi8(a.keys, b.keys, greater), _mm256_blendv_epi8(a.vals, b.vals, greater)};
+            Pairs hi = {_mm256_blendv_epi8(b.keys, a.keys, greater), _mm256_blendv_epi8(b.vals, a.vals, greater)};
+            a = lo;
+            b = hi;
+        }
+
+        // One bitonic step inside a register: lanes selected by BlendMask keep the maxima.
+        // Each lane swaps with its partner only on a strict inequality, so equal keys
+        // never duplicate one payload and drop the other.
+        template<int Shuffle, int BlendMask>
+        __attribute__((target("avx2"))) inline void innerStep(Pairs& x) {
+            __m256i partnerKeys = _mm256_permute4x64_epi64(x.keys, Shuffle);
+            __m256i partnerVals = _mm256_permute4x64_epi64(x.vals, Shuffle);
+            __m256i greater = _mm256_cmpgt_epi64(x.keys, partnerKeys);
+            __m256i less = _mm256_cmpgt_epi64(partnerKeys, x.keys);
+            __m256i takePartner = _mm256_blend_epi32(greater, less, BlendMask);
+            x.keys = _mm256_blendv_epi8(x.keys, partnerKeys, takePartner);
+            x.vals = _mm256_blendv_epi8(x.vals, partnerVals, takePartner);
+        }
+
+        // Merges two sorted registers: a receives the four smallest, b the four largest, both sorted
+        __attribute__((target("avx2"))) inline void bitonicMerge(Pairs& a, Pairs& b) {
+            b.keys = _mm256_permute4x64_epi64(b.keys, 0x1B);  // Reverse b so a:b is bitonic
+            b.vals = _mm256_permute4x64_epi64(b.vals, 0x1B);
+            compareExchange(a, b);
+            innerStep<0x4E, 0xF0>(a);  // Distance 2
+            innerStep<0x4E, 0xF0>(b);
+            innerStep<0xB1, 0xCC>(a);  // Distance 1
+            innerStep<0xB1, 0xCC>(b);
+        }
+
+        __attribute__((target("avx2"))) inline void transpose(__m256i& r0, __m256i& r1, __m256i& r2, __m256i& r3) {
+            __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+            __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+            __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+            __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+            r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+            r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+            r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+            r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+        }
+
+        // Sorts each group of 4 pairs in a block of 16
+        __attribute__((target("avx2"))) inline void sortBlock16(std::int64_t* keys, std::uint64_t* vals) {
+            Pairs r0 = load(keys, vals);
+            Pairs r1 = load(keys + 4, vals + 4);
+            Pairs r2 = load(keys + 8, vals + 8);
+            Pairs r3 = load(keys + 12, vals + 12);
+            // Optimal 4-input network applied to the columns
+            compareExchange(r0, r1);
+            compareExchange(r2, r3);
+            compareExchange(r0, r2);
+            compareExchange(r1, r3);
+            compareExchange(r1, r2);
+            // Columns become rows
+            transpose(r0.keys, r1.keys, r2.keys, r3.keys);
+            transpose(r0.vals, r1.vals, r2.vals, r3.vals);
+            store(keys, vals, r0);
+            store(keys + 4, vals + 4, r1);
+            store(keys + 8, vals + 8, r2);
+            store(keys + 12, vals + 12, r3);
+        }
+
+        // Merges two sorted runs whose lengths are non-zero multiples of 4
+        __attribute__((target("avx2"))) inline void mergeRuns(const std::int64_t* aKeys, const std::uint64_t* aVals, size_t aSize,
+                                                              const std::int64_t* bKeys, const std::uint64_t* bVals, size_t bSize,
+                                                              std::int64_t* outKeys, std::uint64_t* outVals) {
+            Pairs x = load(aKeys, aVals);
+            Pairs y = load(bKeys, bVals);
+            size_t a = 4, b = 4;
+            while (true) {
+                bitonicMerge(x, y);
+                store(outKeys, outVals, x);
+                outKeys += 4;
+                outVals += 4;
+                // y holds the four largest seen so far; refill x from the run with the smaller head
+                if (a < aSize && (b >= bSize || aKeys[a] <= bKeys[b])) {
+                    x = load(aKeys + a, aVals + a);
+                    a += 4;
+                } else if (b < bSize) {
+                    x = load(bKeys + b, bVals + b);
+                    b += 4;
+                } else {
+                    break;
+                }
+            }
+            store(outKeys, outVals, y);
+        }
+
+        /**
+         * @brief Sorts n pairs by key, n a multiple of 16. Uses the two scratch arrays
+         *        as the other half of the ping-pong buffers; the result ends up in keys/vals.
+         */
+        __attribute__((target("avx2"))) inline void sortPairs(std::vector<std::int64_t>& keys, std::vector<std::uint64_t>& vals,
+                                                               std::vector<std::int64_t>& scratchKeys, std::vector<std::uint64_t>& scratchVals) {
+            const size_t n = keys.size();
+            for (size_t i = 0; i < n; i += 16) {
+                sortBlock16(&keys[i], &vals[i]);
+            }
+            for (size_t width = 4; width < n; width *= 2) {
+                for (size_t i = 0; i < n; i += 2 * width) {
+                    if (i + width >= n) {
+                        std::copy(keys.begin() + i, keys.end(), scratchKeys.begin() + i);
+                        std::copy(vals.begin() + i, vals.end(), scratchVals.begin() + i);
+                        continue;
+                    }
+                    size_t bSize = std::min(width, n - i - width);
+                    mergeRuns(&keys[i], &vals[i], width, &keys[i + width], &vals[i + width], bSize,
+                              &scratchKeys[i], &scratchVals[i]);
+                }
+                keys.swap(scratchKeys);
+                vals.swap(scratchVals);
+            }
+        }
+
+    }
+
+    inline bool avx2Supported() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+#else
+
+    inline bool avx2Supported() {
+        return false;
+    }
+
+#endif
+
+    // With AVX2, sortIndex() sends inputs from simdSortThreshold (one block of 16 pairs)
+    // up to these sizes to the SIMD kernel, which beats both std::sort and radix sort
+    // there (bench.cpp index sort benchmark); radix sort takes over above them
+    constexpr size_t simdSortThreshold = 16;
+    constexpr size_t simdRadixThreshold = 128;
+    constexpr size_t simdWideKeyRadixThreshold = 512;
+
+    /**
+     * @brief Sorts index with the AVX2 sorting-network kernel.
+     *
+     * Keys are the radix keys shifted into signed order; the payload is the index.
+     * The input is padded to a multiple of 16 with maximal keys whose payload is an
+     * impossible index, and those padding pairs are filtered out afterwards.
+     * Falls back to std::sort when AVX2 is unavailable.
+     */
+    template<typename T>
+    void simdSortIndex(const std::vector<T>& data, std::vector<size_t>& index) {
+#ifdef DAEL_CONTAINERS_AVX2_SORT
+        if (avx2Supported()) {
+            using Key = typename RadixKey<T>::type;
+            const size_t n = index.size();
+            const size_t padded = (n + 15) / 16 * 16;
+            const std::uint64_t padding = std::numeric_limits<std::uint64_t>::max();
+
+            std::vector<std::int64_t> keys(padded, std::numeric_limits<std::int64_t>::max());
+            std::vector<std::uint64_t> vals(padded, padding);
+            for (size_t i = 0; i < n; ++i) {
+                std::uint64_t key = RadixKey<T>::encode(data[index[i]]);
+                if (sizeof(Key) == 8) {
+                    key ^= std::uint64_t(1) << 63;  // Unsigned order to signed order
+                }
+                keys[i] = static_cast<std::int64_t>(key);
+                vals[i] = index[i];
+            }
+
+            std::vector<std::int64_t> scratchKeys(padded);
+            std::vector<std::uint64_t> scratchVals(padded);
+            avx2::sortPairs(keys, vals, scratchKeys, scratchVals);
+
+            size_t out = 0;
+            for (size_t i = 0; i < padded; ++i) {
+                if (vals[i] != padding) {
+                    index[out++] = static_cast<size_t>(vals[i]);
+                }
+            }
+            return;
+        }
+#endif
+        std::sort(index.begin(), index.end(), [&data](size_t a, size_t b) {
+            return data[a] < data[b];
+        });
+    }
+
+    /**
+     * @brief Splits index into maximal runs that are non-decreasing or strictly
+     *        decreasing by value, reversing the decreasing ones in place.
+     *
+     * Gives up as soon as more than maxRuns runs were found, so on random input
+     * it only looks at a short prefix.
+     * @param runStarts Receives the offset of every run, followed by index.size().
+     * @return True if the whole index consists of at most maxRuns runs.
+     */
+    template<typename T>
+    bool findRuns(const std::vector<T>& data, std::vector<size_t>& index, size_t maxRuns, std::vector<size_t>& runStarts) {
+        const size_t n = index.size();
+        runStarts.clear();
+        size_t start = 0;
+        while (start < n) {
+            if (runStarts.size() == maxRuns) {
+                return false;
+            }
+            runStarts.push_back(start);
+            size_t end = start + 1;
+            if (end < n && data[index[end]] < data[index[start]]) {
+                while (end < n && data[index[end]] < data[index[end - 1]]) {
+                    ++end;
+                }
+                std::reverse(index.begin() + static_cast<std::ptrdiff_t>(start), index.begin() + static_cast<std::ptrdiff_t>(end));
+            } else {
+                while (end < n && !(data[index[end]] < data[index[end - 1]])) {
+                    ++end;
+                }
+            }
+            start = end;
+        }
+        runStarts.push_back(n);
+        return true;
+    }
+
+    /**
+     * @brief Natural merge sort: merges the runs found by findRuns() pairwise until
+     *        one is left. O(n log r) for r runs, O(n) for a single run.
+     */
+    template<typename T>
+    void mergeRunsIndex(const std::vector<T>& data, std::vector<size_t>& index, std::vector<size_t> runStarts) {
+        auto less = [&data](size_t a, size_t b) { return data[a] < data[b]; };
+        std::vector<size_t> buffer(index.size());
+        while (runStarts.size() > 2) {
+            std::vector<size_t> mergedStarts;
+            for (size_t r = 0; r + 1 < runStarts.size(); r += 2) {
+                auto first = index.begin() + static_cast<std::ptrdiff_t>(runStarts[r]);
+                auto middle = index.begin() + static_cast<std::ptrdiff_t>(runStarts[r + 1]);
+                auto last = index.begin() + static_cast<std::ptrdiff_t>(runStarts[std::min(r + 2, runStarts.size() - 1)]);
+                std::merge(first, middle, middle, last, buffer.begin() + (first - index.begin()), less);
+                mergedStarts.push_back(runStarts[r]);
+            }
+            mergedStarts.push_back(index.size());
+            index.swap(buffer);
+            runStarts.swap(mergedStarts);
+        }
+    }
+
+    // Inputs with at most size / comparisonRunDivisor runs are merged instead of
+    // sorted when the fallback is std::sort ...
+    constexpr size_t comparisonRunDivisor = 16;
+    // ... and with at most this many (or fewer) runs when a radix or SIMD kernel is used
+    constexpr size_t arithmeticMaxRuns = 8;
+
+    /**
+     * @brief Sorts index so that data[index[0]] <= data[index[1]] <= ...
+     *
+     * Presorted input is detected first: already sorted or reverse sorted data
+     * costs O(n), and data made of few runs is merged in O(n log runs).
+     * Otherwise the kernel is picked from the element type: integral and
+     * floating-point types go through the AVX2 kernel for small inputs (when the
+     * CPU has AVX2) and are radix sorted above that; everything else, and the
+     * tiniest inputs, use std::sort, which keeps the worst case at O(n log n).
+     */
+    template<typename T>
+    void sortIndex(const std::vector<T>& data, std::vector<size_t>& index) {
+        bool radix = false;
+        bool simd = false;
+        if constexpr (RadixKey<T>::supported) {
+            const bool wideKey = sizeof(typename RadixKey<T>::type) == 8;
+            const bool avx2 = avx2Supported();
+            const size_t radixFrom = avx2 ? (wideKey ? simdWideKeyRadixThreshold : simdRadixThreshold)
+                                          : (wideKey ? wideKeyRadixThreshold : radixSortThreshold);
+            radix = index.size() >= radixFrom;
+            simd = avx2 && !radix && index.size() >= simdSortThreshold;
+        }
+        // Small random inputs have few runs too, so the size-based limit applies to the kernels as well
+        size_t maxRuns = std::max<size_t>(2, index.size() / comparisonRunDivisor);
+        if (radix || simd) {
+            maxRuns = std::min(maxRuns, arithmeticMaxRuns);
+        }
+        std::vector<size_t> runStarts;
+        if (findRuns(data, index, maxRuns, runStarts)) {
+            mergeRunsIndex(data, index, std::move(runStarts));
+            return;
+        }
+
+        if constexpr (RadixKey<T>::supported) {
+            if (radix) {
+                radixSortIndex(data, index);
+                return;
+            }
+            if (simd) {
+                simdSortIndex(data, index);
+                return;
+            }
+        }
+        std::sort(index.begin(), index.end(), [&data](size_t a, size_t b) {
+            return data[a] < data[b];
+        });
+    }
+
+    // Containers from this size up build their sorted view in parallel by default
+    constexpr size_t defaultParallelSortThreshold = size_t(1) << 20;
+
+    /**
+     * @brief Parallel merge sort of index on the shared thread pool.
+     *
+     * The index is cut into one chunk per available thread, every chunk is sorted
+     * with sortIndex() (so it keeps the radix/SIMD kernels), and the sorted chunks
+     * are merged pairwise, each round of merges running in parallel.
+     * The resulting order of values is identical to the serial sortIndex().
+     */
+    template<typename T>
+    void parallelSortIndex(const std::vector<T>& data, std::vector<size_t>& index) {
+        ThreadPool& pool = sharedThreadPool();
+        const size_t n = index.size();
+        const size_t chunkCount = std::min(pool.size() + 1, std::max<size_t>(1, n / 2));
+
+        std::vector<std::vector<size_t>> chunks(chunkCount);
+        pool.parallelFor(chunkCount, [&](size_t c) {
+            auto first = index.begin() + static_cast<std::ptrdiff_t>(n * c / chunkCount);
+            auto last = index.begin() + static_cast<std::ptrdiff_t>(n * (c + 1) / chunkCount);
+            chunks[c].assign(first, last);
+            sortIndex(data, chunks[c]);
+        });
+
+        auto less = [&data](size_t a, size_t b) { return data[a] < data[b]; };
+        while (chunks.size() > 1) {
+            std::vector<std::vector<size_t>> merged((chunks.size() + 1) / 2);
+            pool.parallelFor(merged.size(), [&](size_t m) {
+                if (2 * m + 1 == chunks.size()) {
+                    merged[m] = std::move(chunks[2 * m]);  // Odd one out, carried to the next round
+                    return;
+                }
+                const auto& left = chunks[2 * m];
+                const auto& right = chunks[2 * m + 1];
+                merged[m].resize(left.size() + right.size());
+                std::merge(left.begin(), left.end(), right.begin(), right.end(), merged[m].begin(), less);
+            });
+            chunks.swap(merged);
+        }
+        index.swap(chunks.front());
+    }
+
+}
+
+}
@@ -0,0 +1,154 @@
+//dael12345@gmail.com
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+namespace dael_containers {
+
+namespace detail {
+
+    /**
+     * @class ThreadPool
+     * @brief Fixed set of worker threads used by the parallel code paths of the library.
+     *
+     * The only entry point is parallelFor(), which blocks until every task ran.
+     * The calling thread works on the tasks too, so a parallelFor() issued from
+     * inside another one still makes progress instead of deadlocking.
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> queue;
+        std::mutex mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        // State of one parallelFor() call, shared with the helper jobs it queued
+        struct Batch {
+            const std::function<void(size_t)>* body;
+            size_t count;
+            std::atomic<size_t> next{0};
+            size_t finished = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+
+        // Claims and runs tasks of the batch until none are left
+        static void drain(Batch& batch) {
+            size_t task;
+            while ((task = batch.next++) < batch.count) {
+                std::exception_ptr error;
+                try {
+                    (*batch.body)(task);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (error && !batch.error) {
+                    batch.error = error;
+                }
+                if (++batch.finished == batch.count) {
+                    batch.done.notify_all();
+                }
+            }
+        }
+
+        void workerLoop() {
+            while (true) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [this] { return stopping || !queue.empty(); });
+                    if (queue.empty()) {
+                        return;  // Stopping and nothing left to do
+                    }
+                    job = std::move(queue.front());
+                    queue.pop_front();
+                }
+                job();
+            }
+        }
+
+    public:
+        explicit ThreadPool(size_t threads) {
+            for (size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { workerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+        * @brief Number of worker threads (not counting the threads that call parallelFor()).
+        */
+        size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Runs body(0) ... body(count - 1) on the workers and the calling thread.
+         * @throws Rethrows the first exception thrown by body, after all tasks finished.
+         */
+        void parallelFor(size_t count, const std::function<void(size_t)>& body) {
+            if (count == 0) {
+                return;
+            }
+            auto batch = std::make_shared<Batch>();
+            batch->body = &body;
+            batch->count = count;
+
+            size_t helpers = std::min(count - 1, workers.size());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t i = 0; i < helpers; ++i) {
+                    // A helper that starts after all tasks were claimed returns without touching body
+                    queue.emplace_back([batch] { drain(*batch); });
+                }
+            }
+            wake.notify_all();
+
+            drain(*batch);
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->done.wait(lock, [&batch] { return batch->finished == batch->count; });
+            if (batch->error) {
+                std::rethrow_exception(batch->error);
+            }
+        }
+    };
+
+    /**
+     * @brief The pool shared by the whole library: one worker per hardware thread
+     *        besides the caller, and at least one.
+     */
+    inline ThreadPool& sharedThreadPool() {
+        static ThreadPool pool([] {
+            unsigned hardware = std::thread::hardware_concurrency();
+            return hardware > 1 ? hardware - 1 : 1u;
+        }());
+        return pool;
+    }
+
+}
+
+}
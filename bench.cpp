@@ -0,0 +1,140 @@
+//dael12345@gmail.com
+#include "MyContainer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+using namespace dael_containers;
+
+// Sums a traversal repeatedly and prints the time per element
+template<typename Begin, typename End>
+void measure(const char* name, size_t size, Begin begin, End end) {
+    const int rounds = 2000;
+    std::int64_t sum = std::accumulate(begin(), end(), 0);  // Warm-up round, also builds any sorted view
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        sum += std::accumulate(begin(), end(), 0);  // Sums of one round fit in an int
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed / (static_cast<double>(size) * rounds) << " ns/element"
+              << " (checksum " << sum << ")\n";
+}
+
+template<typename CheckPolicy>
+void run(const char* policy, size_t size) {
+    MyContainer<int, InsertionOrderStorage, CheckPolicy> container;
+    for (size_t i = 0; i < size; ++i) {
+        container.add(static_cast<int>(i % 1000));
+    }
+    std::cout << "--------" << policy << "------------\n";
+    measure("Order", size, [&] { return container.beginOrder(); }, [&] { return container.endOrder(); });
+    measure("Reverse", size, [&] { return container.beginReverse(); }, [&] { return container.endReverse(); });
+    measure("Ascending", size, [&] { return container.beginAscending(); }, [&] { return container.endAscending(); });
+    measure("MiddleOut", size, [&] { return container.beginMiddleOut(); }, [&] { return container.endMiddleOut(); });
+}
+
+// Times random point queries with and without the Eytzinger search index
+void searchBenchmark() {
+    const size_t size = 8'000'000;  // Far larger than the caches
+    const size_t queries = 2'000'000;
+    MyContainer<int, InsertionOrderStorage, Unchecked> container;
+    std::uint32_t state = 1;
+    auto next = [&state] {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int>(state >> 1);
+    };
+    for (size_t i = 0; i < size; ++i) {
+        container.add(next());
+    }
+    std::vector<int> probes(queries);
+    for (int& probe : probes) {
+        probe = next();
+    }
+
+    std::cout << "--------Search (" << size << " elements)------------\n";
+    for (bool indexed : {false, true}) {
+        if (indexed) {
+            container.enableSearchIndex();
+        }
+        size_t checksum = container.countLess(0);  // Builds the sorted view (and the index)
+        auto start = std::chrono::steady_clock::now();
+        for (int probe : probes) {
+            checksum += container.countLess(probe);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (indexed ? "Eytzinger" : "Binary search") << ": " << elapsed / static_cast<double>(queries)
+                  << " ns/query (checksum " << checksum << ")\n";
+    }
+}
+
+// Average time of sorter over index sorts of size random elements. Every round sorts
+// different data, as the sorted view does after each change: sorting one array again and
+// again would let the branch predictor learn std::sort's comparisons at small sizes.
+template<typename T, typename Sorter>
+double timeSort(size_t size, Sorter sorter) {
+    const size_t rounds = std::max<size_t>(20, 2'000'000 / size);
+    std::uint32_t state = 7;
+    std::vector<std::vector<T>> inputs(rounds, std::vector<T>(size));
+    for (auto& input : inputs) {
+        for (T& value : input) {
+            state = state * 1664525u + 1013904223u;
+            value = static_cast<T>(static_cast<std::int32_t>(state));
+        }
+    }
+    std::vector<size_t> index(size);
+    size_t checksum = 0;
+    double elapsed = 0;
+    for (const std::vector<T>& input : inputs) {
+        std::iota(index.begin(), index.end(), size_t{0});
+        auto start = std::chrono::steady_clock::now();
+        sorter(input, index);
+        elapsed += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        checksum += index[size / 2];
+    }
+    volatile size_t sink = checksum;  // Keeps the sorts from being optimized away
+    static_cast<void>(sink);
+    return elapsed / static_cast<double>(rounds);
+}
+
+// Times the index sort kernels, and sortIndex() which picks among them, against std::sort
+template<typename T>
+void sortBenchmark(const char* type) {
+    auto comparisonSort = [](const std::vector<T>& data, std::vector<size_t>& index) {
+        std::sort(index.begin(), index.end(), [&data](size_t a, size_t b) { return data[a] < data[b]; });
+    };
+    auto radixSort = [](const std::vector<T>& data, std::vector<size_t>& index) { detail::radixSortIndex(data, index); };
+    auto simdSort = [](const std::vector<T>& data, std::vector<size_t>& index) { detail::simdSortIndex(data, index); };
+    auto routedSort = [](const std::vector<T>& data, std::vector<size_t>& index) { detail::sortIndex(data, index); };
+
+    std::cout << "--------Index sort, " << type << " (ns per sort)------------\n";
+    for (size_t size : {8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 65536}) {
+        auto report = [size](const char* name, auto sorter) {
+            std::cout << "  " << name << " " << timeSort<T>(size, sorter);
+        };
+        std::cout << size << ":";
+        report("std::sort", comparisonSort);
+        report("radix", radixSort);
+        report("SIMD", simdSort);
+        report("sortIndex", routedSort);
+        std::cout << "\n";
+    }
+}
+
+int main() {
+    const size_t size = 100'000;  // Small enough to stay in cache, so the loop itself is measured
+
+    std::vector<int> raw(size);
+    for (size_t i = 0; i < size; ++i) {
+        raw[i] = static_cast<int>(i % 1000);
+    }
+    std::cout << "--------std::vector------------\n";
+    measure("Pointer walk", size, [&] { return raw.data(); }, [&] { return raw.data() + raw.size(); });
+
+    run<BoundsChecked>("BoundsChecked", size);
+    run<Unchecked>("Unchecked", size);
+
+    searchBenchmark();
+    sortBenchmark<int>("int");
+    sortBenchmark<double>("double");
+    return 0;
+}
@@ -3,6 +3,19 @@
 #include "doctest.h"
 #include "MyContainer.hpp"
 #include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <iterator>
+#include <type_traits>
+#include <ranges>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <span>
+#include <string>
+#include <cctype>
 
 using namespace dael_containers;
 
@@ -275,3 +288,1229 @@ TEST_CASE("Char container") {
 }
 
 
+TEST_CASE("Sorted iterators follow add and remove") {
+    MyContainer<int> container;
+    container.add(7);
+    container.add(15);
+    container.add(6);
+
+    std::vector<int> before;
+    for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+        before.push_back(*it);
+    CHECK(before == std::vector<int>{6, 7, 15});
+
+    container.add(1);
+    container.remove(15);
+
+    std::vector<int> ascending;
+    for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+        ascending.push_back(*it);
+    CHECK(ascending == std::vector<int>{1, 6, 7});
+
+    std::vector<int> descending;
+    for (auto it = container.beginDescending(); it != container.endDescending(); ++it)
+        descending.push_back(*it);
+    CHECK(descending == std::vector<int>{7, 6, 1});
+
+    std::vector<int> sideCross;
+    for (auto it = container.beginSideCross(); it != container.endSideCross(); ++it)
+        sideCross.push_back(*it);
+    CHECK(sideCross == std::vector<int>{1, 7, 6});
+}
+
+TEST_CASE("String container sorted iterators") {
+    MyContainer<std::string> container;
+    container.add("pear");
+    container.add("apple");
+    container.add("fig");
+    container.add("banana");
+
+    std::vector<std::string> ascending;
+    for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+        ascending.push_back(*it);
+    CHECK(ascending == std::vector<std::string>{"apple", "banana", "fig", "pear"});
+
+    std::vector<std::string> descending;
+    for (auto it = container.beginDescending(); it != container.endDescending(); ++it)
+        descending.push_back(*it);
+    CHECK(descending == std::vector<std::string>{"pear", "fig", "banana", "apple"});
+
+    std::vector<std::string> sideCross;
+    for (auto it = container.beginSideCross(); it != container.endSideCross(); ++it)
+        sideCross.push_back(*it);
+    CHECK(sideCross == std::vector<std::string>{"apple", "pear", "banana", "fig"});
+}
+
+TEST_CASE("Lazy Ascending and Descending traversal") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 6})
+        container.add(value);
+
+    SUBCASE("Full lazy traversal matches the sorted order") {
+        std::vector<int> ascending;
+        for (auto it = container.beginAscending(TraversalMode::Lazy); it != container.endAscending(); ++it)
+            ascending.push_back(*it);
+        CHECK(ascending == std::vector<int>{1, 2, 6, 6, 7, 15});
+
+        std::vector<int> descending;
+        for (auto it = container.beginDescending(TraversalMode::Lazy); it != container.endDescending(); ++it)
+            descending.push_back(*it);
+        CHECK(descending == std::vector<int>{15, 7, 6, 6, 2, 1});
+    }
+
+    SUBCASE("Early break") {
+        auto it = container.beginAscending(TraversalMode::Lazy);
+        CHECK(*it == 1);
+        ++it;
+        CHECK(*it == 2);
+    }
+
+    SUBCASE("Empty container") {
+        MyContainer<int> empty;
+        CHECK(empty.beginAscending(TraversalMode::Lazy) == empty.endAscending());
+        CHECK(empty.beginDescending(TraversalMode::Lazy) == empty.endDescending());
+    }
+}
+
+TEST_CASE("topK and bottomK") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2})
+        container.add(value);
+
+    CHECK(container.topK(2) == std::vector<int>{15, 7});
+    CHECK(container.bottomK(3) == std::vector<int>{1, 2, 6});
+    CHECK(container.topK(10) == std::vector<int>{15, 7, 6, 2, 1});
+    CHECK(container.bottomK(0).empty());
+
+    // Same answers once the sorted view has been built
+    container.beginAscending();
+    CHECK(container.topK(2) == std::vector<int>{15, 7});
+    CHECK(container.bottomK(3) == std::vector<int>{1, 2, 6});
+}
+
+TEST_CASE("Lazy SideCross traversal") {
+    SUBCASE("Matches the snapshot traversal") {
+        MyContainer<int> container;
+        for (int value : {7, 15, 6, 1, 2, 9, 6, 4})
+            container.add(value);
+
+        std::vector<int> lazy;
+        for (auto it = container.beginSideCross(TraversalMode::Lazy); it != container.endSideCross(); ++it)
+            lazy.push_back(*it);
+        CHECK(lazy == std::vector<int>{1, 15, 2, 9, 4, 7, 6, 6});
+    }
+
+    SUBCASE("Larger pseudo-random input") {
+        MyContainer<int> container;
+        unsigned state = 12345;
+        for (int i = 0; i < 500; ++i) {
+            state = state * 1103515245u + 12345u;
+            container.add(static_cast<int>((state >> 16) % 100));
+        }
+
+        std::vector<int> lazy;
+        for (auto it = container.beginSideCross(TraversalMode::Lazy); it != container.endSideCross(); ++it)
+            lazy.push_back(*it);
+
+        std::vector<int> snapshot;
+        for (auto it = container.beginSideCross(); it != container.endSideCross(); ++it)
+            snapshot.push_back(*it);
+
+        CHECK(lazy == snapshot);
+    }
+
+    SUBCASE("Empty and single element") {
+        MyContainer<int> empty;
+        CHECK(empty.beginSideCross(TraversalMode::Lazy) == empty.endSideCross());
+
+        MyContainer<int> single;
+        single.add(42);
+        auto it = single.beginSideCross(TraversalMode::Lazy);
+        CHECK(*it == 42);
+        ++it;
+        CHECK(it == single.endSideCross());
+    }
+}
+
+TEST_CASE("Radix sorted snapshot for arithmetic types") {
+    unsigned state = 2024;
+    auto next = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return state;
+    };
+
+    SUBCASE("Signed integers") {
+        MyContainer<int> container;
+        std::vector<int> expected;
+        for (int i = 0; i < 20000; ++i) {
+            int value = static_cast<int>(next()) / 3;  // Mix of negative and positive values
+            container.add(value);
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> actual;
+        for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+            actual.push_back(*it);
+        CHECK(actual == expected);
+    }
+
+    SUBCASE("Doubles with negatives and fractions") {
+        MyContainer<double> container;
+        std::vector<double> expected;
+        for (int i = 0; i < 20000; ++i) {
+            double value = (static_cast<double>(next() % 20001) - 10000.0) / 7.0;
+            container.add(value);
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<double> actual;
+        for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+            actual.push_back(*it);
+        CHECK(actual == expected);
+    }
+
+    SUBCASE("Chars") {
+        MyContainer<char> container;
+        std::vector<char> expected;
+        for (int i = 0; i < 10000; ++i) {
+            char value = static_cast<char>(next() >> 8);
+            container.add(value);
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end(), std::greater<char>());
+
+        std::vector<char> actual;
+        for (auto it = container.beginDescending(); it != container.endDescending(); ++it)
+            actual.push_back(*it);
+        CHECK(actual == expected);
+    }
+}
+
+TEST_CASE("SIMD sort kernel") {
+    // Sizes around the 16-element block and run boundaries, with many duplicates
+    unsigned state = 77;
+    for (size_t n : {1u, 15u, 16u, 17u, 31u, 100u, 255u, 700u}) {
+        std::vector<long long> values(n);
+        for (auto& value : values) {
+            state = state * 1103515245u + 12345u;
+            value = static_cast<long long>(state % 50) - 25;
+        }
+        std::vector<size_t> index(n);
+        std::iota(index.begin(), index.end(), size_t{0});
+        detail::simdSortIndex(values, index);
+
+        std::vector<size_t> permutation(index);
+        std::sort(permutation.begin(), permutation.end());
+        std::vector<size_t> identity(n);
+        std::iota(identity.begin(), identity.end(), size_t{0});
+        CHECK(permutation == identity);
+        CHECK(std::is_sorted(index.begin(), index.end(), [&values](size_t a, size_t b) {
+            return values[a] < values[b];
+        }));
+
+        // sortIndex() routes these sizes to the SIMD kernel when the CPU has AVX2
+        std::vector<size_t> routed(n);
+        std::iota(routed.begin(), routed.end(), size_t{0});
+        detail::sortIndex(values, routed);
+        bool sameValues = true;
+        for (size_t i = 0; i < n; ++i) sameValues = sameValues && values[routed[i]] == values[index[i]];
+        CHECK(sameValues);
+    }
+}
+
+TEST_CASE("Parallel sorted view matches the serial one") {
+    MyContainer<int> serial;
+    MyContainer<int> parallel;
+    MyContainer<std::string> parallelStrings;
+    parallel.setParallelSortThreshold(100);
+    parallelStrings.setParallelSortThreshold(100);
+
+    unsigned state = 99;
+    for (int i = 0; i < 5000; ++i) {
+        state = state * 1103515245u + 12345u;
+        int value = static_cast<int>(state >> 8) % 1000;
+        serial.add(value);
+        parallel.add(value);
+        parallelStrings.add(std::to_string(value));
+    }
+
+    std::vector<int> expected;
+    for (auto it = serial.beginAscending(); it != serial.endAscending(); ++it)
+        expected.push_back(*it);
+
+    std::vector<int> actual;
+    for (auto it = parallel.beginAscending(); it != parallel.endAscending(); ++it)
+        actual.push_back(*it);
+    CHECK(actual == expected);
+
+    std::vector<std::string> strings;
+    for (auto it = parallelStrings.beginAscending(); it != parallelStrings.endAscending(); ++it)
+        strings.push_back(*it);
+    CHECK(std::is_sorted(strings.begin(), strings.end()));
+    CHECK(strings.size() == 5000);
+}
+
+TEST_CASE("Adaptive sort of presorted input") {
+    auto ascending = [](const auto& container) {
+        std::vector<typename std::decay_t<decltype(*container.beginAscending())>> values;
+        for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+            values.push_back(*it);
+        return values;
+    };
+
+    SUBCASE("Already sorted, reverse sorted and interleaved runs") {
+        MyContainer<int> sorted;
+        MyContainer<int> reversed;
+        MyContainer<int> runs;
+        std::vector<int> expected;
+        for (int i = 0; i < 3000; ++i) {
+            sorted.add(i);
+            reversed.add(2999 - i);
+            runs.add((i % 3) * 1000 + i / 3);  // Three interleaved ascending sequences
+            expected.push_back(i);
+        }
+        CHECK(ascending(sorted) == expected);
+        CHECK(ascending(reversed) == expected);
+
+        std::vector<int> runsExpected;
+        for (int i = 0; i < 3000; ++i)
+            runsExpected.push_back((i % 3) * 1000 + i / 3);
+        std::sort(runsExpected.begin(), runsExpected.end());
+        CHECK(ascending(runs) == runsExpected);
+    }
+
+    SUBCASE("Nearly sorted strings with duplicates") {
+        MyContainer<std::string> container;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 500; ++i) {
+            std::string value = std::to_string(10000 + i / 2);
+            container.add(value);
+            expected.push_back(value);
+        }
+        container.add("09999");
+        expected.insert(expected.begin(), "09999");
+        CHECK(ascending(container) == expected);
+    }
+
+    SUBCASE("Descending runs with equal neighbours") {
+        MyContainer<double> container;
+        for (double value : {5.0, 5.0, 3.0, 3.0, 1.0, 4.0, 2.0, 2.0})
+            container.add(value);
+        CHECK(ascending(container) == std::vector<double>{1.0, 2.0, 2.0, 3.0, 3.0, 4.0, 5.0, 5.0});
+    }
+}
+
+TEST_CASE("Sorted iterators on data added in order") {
+    MyContainer<int> container;
+    for (int value : {1, 2, 2, 5, 8})
+        container.add(value);
+
+    std::vector<int> ascending;
+    for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+        ascending.push_back(*it);
+    CHECK(ascending == std::vector<int>{1, 2, 2, 5, 8});
+
+    std::vector<int> descending;
+    for (auto it = container.beginDescending(); it != container.endDescending(); ++it)
+        descending.push_back(*it);
+    CHECK(descending == std::vector<int>{8, 5, 2, 2, 1});
+
+    std::vector<int> sideCross;
+    for (auto it = container.beginSideCross(TraversalMode::Lazy); it != container.endSideCross(); ++it)
+        sideCross.push_back(*it);
+    CHECK(sideCross == std::vector<int>{1, 8, 2, 5, 2});
+
+    CHECK(container.topK(2) == std::vector<int>{8, 5});
+
+    // Removing keeps the data sorted, an out-of-order add does not
+    container.remove(2);
+    container.add(0);
+    ascending.clear();
+    for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+        ascending.push_back(*it);
+    CHECK(ascending == std::vector<int>{0, 1, 5, 8});
+}
+
+TEST_CASE("Sorted view stays correct across interleaved add and remove") {
+    MyContainer<int> container;
+    std::vector<int> reference;
+    unsigned state = 7;
+    auto next = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return static_cast<int>((state >> 16) % 60);
+    };
+
+    for (int round = 0; round < 40; ++round) {
+        for (int i = 0; i < 25; ++i) {
+            int value = next();
+            container.add(value);
+            reference.push_back(value);
+        }
+        if (round % 3 == 0) {
+            int value = reference[static_cast<size_t>(next()) % reference.size()];
+            container.remove(value);
+            reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+        }
+
+        std::vector<int> expected(reference);
+        std::sort(expected.begin(), expected.end());
+        std::vector<int> actual;
+        for (auto it = container.beginAscending(); it != container.endAscending(); ++it)
+            actual.push_back(*it);
+        REQUIRE(actual == expected);
+    }
+
+    // Removing from an up-to-date view, then traversing without any add in between
+    int value = reference.front();
+    container.remove(value);
+    reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+    std::sort(reference.begin(), reference.end(), std::greater<int>());
+    std::vector<int> descending;
+    for (auto it = container.beginDescending(); it != container.endDescending(); ++it)
+        descending.push_back(*it);
+    CHECK(descending == reference);
+}
+
+TEST_CASE("SortedStorage policy") {
+    MyContainer<int, SortedStorage> container;
+    for (int value : {7, 15, 6, 1, 2})
+        container.add(value);
+
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> values;
+        for (auto it = begin; it != end; ++it)
+            values.push_back(*it);
+        return values;
+    };
+
+    CHECK(collect(container.beginAscending(), container.endAscending()) == std::vector<int>{1, 2, 6, 7, 15});
+    CHECK(collect(container.beginDescending(), container.endDescending()) == std::vector<int>{15, 7, 6, 2, 1});
+    CHECK(collect(container.beginSideCross(), container.endSideCross()) == std::vector<int>{1, 15, 2, 7, 6});
+    CHECK(collect(container.beginReverse(), container.endReverse()) == std::vector<int>{2, 1, 6, 15, 7});
+    CHECK(collect(container.beginOrder(), container.endOrder()) == std::vector<int>{7, 15, 6, 1, 2});
+    CHECK(collect(container.beginMiddleOut(), container.endMiddleOut()) == std::vector<int>{6, 15, 1, 7, 2});
+
+    std::ostringstream printed;
+    printed << container;
+    CHECK(printed.str() == "[7, 15, 6, 1, 2]");
+
+    container.add(6);
+    container.remove(15);
+    CHECK(container.size() == 5);
+    CHECK(collect(container.beginOrder(), container.endOrder()) == std::vector<int>{7, 6, 1, 2, 6});
+    CHECK(collect(container.beginAscending(), container.endAscending()) == std::vector<int>{1, 2, 6, 6, 7});
+    CHECK_THROWS_AS(container.remove(100), std::runtime_error);
+
+    container.remove(6);
+    CHECK(collect(container.beginReverse(), container.endReverse()) == std::vector<int>{2, 1, 7});
+}
+
+TEST_CASE("SortedStorage insertion order follows interleaved adds and removes") {
+    // The insertion-order view is rebuilt from per-element stamps; compare it with
+    // a container that stores insertion order directly
+    MyContainer<int, SortedStorage> sorted;
+    MyContainer<int> plain;
+    for (int i = 0; i < 300; ++i) {
+        int value = (i * 37) % 23;
+        if (i % 5 == 4 && plain.size() > 0) {
+            int victim = *plain.beginOrder();
+            sorted.remove(victim);
+            plain.remove(victim);
+        } else {
+            sorted.add(value);
+            plain.add(value);
+        }
+        if (i % 50 == 0 || i == 299) {
+            CHECK(std::equal(sorted.beginOrder(), sorted.endOrder(), plain.beginOrder(), plain.endOrder()));
+            CHECK(std::equal(sorted.beginReverse(), sorted.endReverse(), plain.beginReverse(), plain.endReverse()));
+            CHECK(std::equal(sorted.beginMiddleOut(), sorted.endMiddleOut(), plain.beginMiddleOut(), plain.endMiddleOut()));
+        }
+    }
+    CHECK(std::is_sorted(sorted.beginAscending(), sorted.endAscending()));
+
+    // An end iterator resolves the view only when dereferenced
+    auto last = sorted.endOrder();
+    --last;
+    CHECK(*last == *(--plain.endOrder()));
+}
+
+TEST_CASE("Order statistics: select, rank and countLess") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 6})
+        container.add(value);
+
+    SUBCASE("Without the index") {
+        CHECK_FALSE(container.hasOrderStatistics());
+        CHECK(container.select(0) == 1);
+        CHECK(container.select(5) == 15);
+        CHECK(container.countLess(6) == 2);
+        CHECK(container.countLess(100) == 6);
+        CHECK(container.rank(7) == 4);
+        CHECK_THROWS_AS(container.rank(5), std::runtime_error);
+        CHECK_THROWS_AS(container.select(6), std::out_of_range);
+        CHECK_THROWS_AS(container.orderStatistics(), std::logic_error);
+    }
+
+    SUBCASE("With the index") {
+        container.enableOrderStatistics();
+        CHECK(container.hasOrderStatistics());
+        CHECK(container.select(2) == 6);
+        CHECK(container.rank(15) == 5);
+        container.add(3);
+        container.remove(6);
+        CHECK(container.countLess(7) == 3);
+        CHECK(container.select(3) == 7);
+
+        std::vector<int> fromThree;
+        const auto& tree = container.orderStatistics();
+        for (auto it = tree.lowerBound(3); it != tree.end(); ++it)
+            fromThree.push_back(*it);
+        CHECK(fromThree == std::vector<int>{3, 7, 15});
+    }
+}
+
+TEST_CASE("Order statistics stay correct under many updates") {
+    MyContainer<int> container;
+    container.enableOrderStatistics();
+    std::vector<int> reference;
+    unsigned state = 31;
+    auto next = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return static_cast<int>((state >> 16) % 500);
+    };
+
+    for (int i = 0; i < 6000; ++i) {
+        int value = next();
+        container.add(value);
+        reference.push_back(value);
+    }
+    // Remove most values so the tree goes through its shrink-and-rebuild path
+    for (int value = 0; value < 450; ++value) {
+        if (std::find(reference.begin(), reference.end(), value) != reference.end()) {
+            container.remove(value);
+            reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+        }
+    }
+    for (int i = 0; i < 300; ++i) {
+        int value = next();
+        container.add(value);
+        reference.push_back(value);
+    }
+    std::sort(reference.begin(), reference.end());
+
+    const auto& tree = container.orderStatistics();
+    CHECK(tree.size() == reference.size());
+    CHECK(tree.toVector() == reference);
+
+    bool selectMatches = true;
+    for (size_t k = 0; k < reference.size(); ++k)
+        selectMatches = selectMatches && container.select(k) == reference[k];
+    CHECK(selectMatches);
+
+    bool countsMatch = true;
+    for (int value = -1; value <= 501; ++value) {
+        size_t expected = static_cast<size_t>(std::lower_bound(reference.begin(), reference.end(), value) - reference.begin());
+        countsMatch = countsMatch && container.countLess(value) == expected;
+    }
+    CHECK(countsMatch);
+
+    // A copy carries its own index
+    MyContainer<int> copy = container;
+    copy.add(-5);
+    CHECK(copy.select(0) == -5);
+    CHECK(container.select(0) == reference.front());
+}
+
+TEST_CASE("Moved-from containers can be reused") {
+    auto ascending = [](const auto& container) {
+        return std::vector<int>(container.beginAscending(), container.endAscending());
+    };
+
+    MyContainer<int> source;
+    for (int v : {1, 2, 3, 4}) source.add(v);
+    source.enableSearchIndex();
+    CHECK(source.countLess(3) == 2);
+    MyContainer<int> target = std::move(source);
+    CHECK(ascending(target) == std::vector<int>{1, 2, 3, 4});
+
+    source.add(9);
+    source.add(0);
+    CHECK(ascending(source) == std::vector<int>{0, 9});
+    CHECK(source.countLess(9) == 1);
+    source.remove(9);
+    CHECK(ascending(source) == std::vector<int>{0});
+
+    // Move assignment, also under SortedStorage and with the order-statistic index
+    MyContainer<int, SortedStorage> sorted;
+    for (int v : {5, 3, 8}) sorted.add(v);
+    sorted.enableOrderStatistics();
+    MyContainer<int, SortedStorage> other;
+    other = std::move(sorted);
+    CHECK(other.select(0) == 3);
+    sorted.add(7);
+    sorted.add(1);
+    sorted.remove(7);
+    CHECK(std::vector<int>(sorted.beginOrder(), sorted.endOrder()) == std::vector<int>{1});
+    CHECK(sorted.select(0) == 1);
+    CHECK(sorted.size() == 1);
+}
+
+// An element type with no default constructor
+struct Key {
+    int id;
+    explicit Key(int value) : id(value) {}
+    bool operator<(const Key& other) const { return id < other.id; }
+    bool operator==(const Key& other) const { return id == other.id; }
+};
+
+TEST_CASE("Element types without a default constructor") {
+    MyContainer<Key> container;
+    for (int i = 0; i < 300; ++i) container.add(Key((i * 37) % 300));
+    container.remove(Key(5));
+    CHECK(container.size() == 299);
+    CHECK(container.beginAscending()->id == 0);
+    CHECK(container.beginDescending()->id == 299);
+
+    // Leaf and inner node splits in the order-statistic tree
+    container.enableOrderStatistics();
+    for (int i = 300; i < 5000; ++i) container.add(Key(i));
+    CHECK(container.select(5).id == 6);
+
+    // Range queries, with and without the search index
+    CHECK(container.countLess(Key(10)) == 9);
+    CHECK(container.countInRange(Key(0), Key(100)) == 99);
+    container.enableSearchIndex();
+    CHECK(container.lowerBound(Key(5))->id == 6);
+    CHECK(container.countInRange(Key(290), Key(310)) == 20);
+}
+
+TEST_CASE("Random-access iterators") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2, 9}) container.add(v);
+
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::AscendingOrderIterator>::iterator_category,
+                               std::random_access_iterator_tag>::value, "AscendingOrderIterator is random access");
+
+    SUBCASE("Jumps, distances and subscript") {
+        auto begin = container.beginAscending();
+        auto end = container.endAscending();
+        CHECK(end - begin == 6);
+        CHECK(std::distance(begin, end) == 6);
+        CHECK(begin[3] == 7);
+        CHECK(*(begin + 5) == 15);
+        CHECK(*(end - 1) == 15);
+        CHECK(*std::prev(end) == 15);
+        CHECK(*(2 + begin) == 6);
+        CHECK(begin < end);
+        CHECK(end >= begin);
+
+        auto it = begin;
+        CHECK(*it++ == 1);
+        CHECK(*it == 2);
+        it += 3;
+        CHECK(*it == 9);
+        it -= 2;
+        CHECK(*it-- == 6);
+        CHECK(*it == 2);
+        CHECK(*--end == 15);
+    }
+
+    SUBCASE("Standard algorithms") {
+        auto found = std::lower_bound(container.beginAscending(), container.endAscending(), 8);
+        CHECK(*found == 9);
+        CHECK(std::binary_search(container.beginAscending(), container.endAscending(), 6));
+        CHECK(std::is_sorted(container.beginAscending(), container.endAscending()));
+        CHECK(std::is_sorted(container.beginDescending(), container.endDescending(), std::greater<int>()));
+
+        std::vector<int> reversed(container.beginReverse(), container.endReverse());
+        CHECK(reversed == std::vector<int>{9, 2, 1, 6, 15, 7});
+        std::vector<int> backwards(std::make_reverse_iterator(container.endOrder()),
+                                   std::make_reverse_iterator(container.beginOrder()));
+        CHECK(backwards == reversed);
+    }
+
+    SUBCASE("Every order supports random access") {
+        CHECK(container.beginDescending()[1] == 9);
+        CHECK(*(container.endDescending() - 1) == 1);
+        CHECK(container.beginSideCross()[3] == 9);
+        CHECK(*(container.endSideCross() - 1) == 7);
+        CHECK(container.beginReverse()[1] == 2);
+        CHECK(container.beginOrder()[4] == 2);
+        CHECK(container.beginMiddleOut()[2] == 2);
+        CHECK(*(container.endMiddleOut() - 1) == 7);
+        CHECK(container.beginDescending(TraversalMode::Lazy)[2] == 7);
+        CHECK(container.endSideCross() - container.beginSideCross(TraversalMode::Lazy) == 6);
+    }
+
+    SUBCASE("Iterators are default constructible and assignable") {
+        MyContainer<int>::OrderIterator it;
+        it = container.beginOrder();
+        CHECK(*it == 7);
+    }
+}
+
+TEST_CASE("Ranges views") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2}) container.add(v);
+
+    static_assert(std::ranges::view<decltype(container.ascending())>);
+    static_assert(std::ranges::random_access_range<decltype(container.middleOut())>);
+    static_assert(std::ranges::sized_range<decltype(container.order())>);
+
+    auto collect = [](auto&& range) {
+        std::vector<int> out;
+        for (int v : range) out.push_back(v);
+        return out;
+    };
+
+    CHECK(collect(container.ascending()) == std::vector<int>{1, 2, 6, 7, 15});
+    CHECK(collect(container.descending()) == std::vector<int>{15, 7, 6, 2, 1});
+    CHECK(collect(container.sideCross()) == std::vector<int>{1, 15, 2, 7, 6});
+    CHECK(collect(container.reverse()) == std::vector<int>{2, 1, 6, 15, 7});
+    CHECK(collect(container.order()) == std::vector<int>{7, 15, 6, 1, 2});
+    CHECK(collect(container.middleOut()) == std::vector<int>{6, 15, 1, 7, 2});
+    CHECK(container.ascending().size() == 5);
+
+    SUBCASE("Views compose with range adaptors") {
+        auto evenSquares = container.ascending()
+            | std::views::filter([](int v) { return v % 2 == 0; })
+            | std::views::transform([](int v) { return v * v; });
+        CHECK(collect(evenSquares) == std::vector<int>{4, 36});
+
+        CHECK(collect(container.descending(TraversalMode::Lazy) | std::views::take(2)) == std::vector<int>{15, 7});
+        CHECK(collect(container.order() | std::views::reverse) == collect(container.reverse()));
+        CHECK(std::ranges::max(container.sideCross() | std::views::drop(1)) == 15);
+    }
+
+    SUBCASE("take stops a lazy traversal early") {
+        int reads = 0;
+        auto counted = container.ascending(TraversalMode::Lazy)
+            | std::views::transform([&reads](int v) { ++reads; return v; })
+            | std::views::take(2);
+        CHECK(collect(counted) == std::vector<int>{1, 2});
+        CHECK(reads == 2);
+    }
+}
+
+TEST_CASE("Check policies") {
+    // Debug builds check by default, release (NDEBUG) builds do not
+#ifdef NDEBUG
+    CHECK(std::is_same<DefaultCheckPolicy, Unchecked>::value);
+#else
+    CHECK(std::is_same<DefaultCheckPolicy, BoundsChecked>::value);
+#endif
+
+    MyContainer<int, InsertionOrderStorage, BoundsChecked> checked;
+    MyContainer<int, InsertionOrderStorage, Unchecked> unchecked;
+    for (int v : {7, 15, 6, 1, 2}) {
+        checked.add(v);
+        unchecked.add(v);
+    }
+
+    CHECK_THROWS_AS(*checked.endOrder(), std::out_of_range);
+    CHECK_THROWS_AS(*checked.endAscending(), std::out_of_range);
+    CHECK_THROWS_AS(*(checked.beginReverse() - 1), std::out_of_range);
+
+    // Unchecked iterators produce the same traversals
+    CHECK(std::equal(unchecked.beginOrder(), unchecked.endOrder(), checked.beginOrder()));
+    CHECK(std::equal(unchecked.beginReverse(), unchecked.endReverse(), checked.beginReverse()));
+    CHECK(std::equal(unchecked.beginAscending(), unchecked.endAscending(), checked.beginAscending()));
+    CHECK(std::equal(unchecked.beginDescending(), unchecked.endDescending(), checked.beginDescending()));
+    CHECK(std::equal(unchecked.beginSideCross(), unchecked.endSideCross(), checked.beginSideCross()));
+    CHECK(std::equal(unchecked.beginMiddleOut(), unchecked.endMiddleOut(), checked.beginMiddleOut()));
+}
+
+TEST_CASE("MiddleOut order for every size") {
+    // Reference: middle, then alternately one more to the left and one more to the right
+    auto expectedOrder = [](int size) {
+        std::vector<int> order;
+        if (size == 0) return order;
+        int middle = size / 2;
+        order.push_back(middle);
+        for (int offset = 1; static_cast<int>(order.size()) < size; ++offset) {
+            if (middle - offset >= 0) order.push_back(middle - offset);
+            if (middle + offset < size) order.push_back(middle + offset);
+        }
+        return order;
+    };
+
+    MyContainer<int> container;
+    bool allMatch = true;
+    for (int size = 0; size <= 40; ++size) {
+        std::vector<int> visited(container.beginMiddleOut(), container.endMiddleOut());
+        allMatch = allMatch && visited == expectedOrder(size);
+        container.add(size);  // Values equal their insertion index
+    }
+    CHECK(allMatch);
+
+    // 41 elements: the walk ends on the right edge
+    CHECK(*(container.endMiddleOut() - 1) == 40);
+    CHECK(container.beginMiddleOut()[39] == 0);
+}
+
+TEST_CASE("Traversal beyond 2^31 elements" * doctest::skip()) {
+    // Opt-in (./test --no-skip): needs about 3 GB of memory and a few minutes.
+    // The data is added in ascending order, so no sorted view is allocated.
+    const size_t size = 3'000'000'000;
+    MyContainer<std::uint8_t, InsertionOrderStorage, Unchecked> container;
+    container.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        container.add(static_cast<std::uint8_t>(i / (size / 250)));
+    }
+    REQUIRE(container.size() == size);
+
+    const std::ptrdiff_t length = static_cast<std::ptrdiff_t>(size);
+    CHECK(container.endAscending() - container.beginAscending() == length);
+    CHECK(container.endDescending() - container.beginDescending() == length);
+    CHECK(container.endSideCross() - container.beginSideCross() == length);
+    CHECK(container.endReverse() - container.beginReverse() == length);
+    CHECK(container.endOrder() - container.beginOrder() == length);
+    CHECK(container.endMiddleOut() - container.beginMiddleOut() == length);
+
+    // Positions past 2^31, where an int index would have wrapped
+    const size_t far = (size_t{1} << 31) + 12345;
+    const std::uint8_t farValue = static_cast<std::uint8_t>(far / (size / 250));
+    const std::uint8_t lastValue = static_cast<std::uint8_t>((size - 1) / (size / 250));
+    CHECK(container.beginOrder()[static_cast<std::ptrdiff_t>(far)] == farValue);
+    CHECK(container.beginAscending()[static_cast<std::ptrdiff_t>(far)] == farValue);
+    CHECK(container.beginReverse()[static_cast<std::ptrdiff_t>(size - 1 - far)] == farValue);
+    CHECK(container.beginDescending()[static_cast<std::ptrdiff_t>(size - 1 - far)] == farValue);
+    CHECK(*container.beginDescending() == lastValue);
+    CHECK(*(container.endReverse() - 1) == 0);
+    CHECK(*container.beginMiddleOut() == static_cast<std::uint8_t>((size / 2) / (size / 250)));
+    CHECK(*(container.endMiddleOut() - 1) == 0);
+    CHECK(*(container.endSideCross() - 1) == static_cast<std::uint8_t>((size / 2) / (size / 250)));
+
+    // Full walks end exactly at the end iterators
+    size_t steps = 0;
+    std::uint8_t previous = lastValue;
+    bool descending = true;
+    for (auto it = container.beginDescending(); it != container.endDescending(); ++it, ++steps) {
+        descending = descending && *it <= previous;
+        previous = *it;
+    }
+    CHECK(descending);
+    CHECK(steps == size);
+
+    std::uint64_t reverseSum = 0;
+    for (auto it = container.beginReverse(); it != container.endReverse(); ++it) {
+        reverseSum += *it;
+    }
+    CHECK(reverseSum == std::accumulate(container.beginOrder(), container.endOrder(), std::uint64_t{0}));
+}
+
+TEST_CASE("Split and parallel traversal") {
+    MyContainer<int> container;
+    for (int i = 0; i < 100000; ++i) {
+        container.add((i * 7919) % 100003);
+    }
+    std::vector<int> ascending(container.beginAscending(), container.endAscending());
+
+    SUBCASE("Sub-ranges cover the traversal in order") {
+        auto parts = container.split<IterationOrder::Ascending>(7);
+        REQUIRE(parts.size() == 7);
+        std::vector<int> joined;
+        for (const auto& part : parts) {
+            CHECK(part.size() >= 100000 / 7);
+            CHECK(part.size() <= 100000 / 7 + 1);
+            joined.insert(joined.end(), part.begin(), part.end());
+        }
+        CHECK(joined == ascending);
+
+        std::vector<int> middleOut;
+        for (const auto& part : container.split<IterationOrder::MiddleOut>(3)) {
+            middleOut.insert(middleOut.end(), part.begin(), part.end());
+        }
+        CHECK(middleOut == std::vector<int>(container.beginMiddleOut(), container.endMiddleOut()));
+
+        MyContainer<int> small;
+        small.add(1);
+        auto smallParts = small.split<IterationOrder::Reverse>(4);
+        CHECK(smallParts.size() == 4);
+        CHECK(smallParts[0].size() == 1);
+        CHECK(smallParts[3].empty());
+    }
+
+    SUBCASE("parallelForEach visits every element once") {
+        long long expected = std::accumulate(ascending.begin(), ascending.end(), 0LL);
+        for (IterationOrder order : {IterationOrder::Ascending, IterationOrder::Descending, IterationOrder::SideCross,
+                                     IterationOrder::Reverse, IterationOrder::Order, IterationOrder::MiddleOut}) {
+            std::atomic<long long> sum{0};
+            std::atomic<size_t> count{0};
+            container.parallelForEach(order, [&](int value) {
+                sum += value;
+                ++count;
+            });
+            CHECK(sum == expected);
+            CHECK(count == container.size());
+        }
+    }
+
+    SUBCASE("Const traversals from several threads share one sorted view") {
+        MyContainer<int> shared;
+        for (int i = 0; i < 50000; ++i) shared.add((i * 7919) % 50021);
+        shared.enableSearchIndex();
+        std::vector<long long> firsts(8);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < firsts.size(); ++t) {
+            threads.emplace_back([&shared, &firsts, t] {
+                firsts[t] = t % 2 == 0 ? *shared.beginAscending() : *shared.beginDescending();
+                firsts[t] += static_cast<long long>(shared.countInRange(0, 100));
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (size_t t = 0; t < firsts.size(); ++t) {
+            CHECK(firsts[t] == (t % 2 == 0 ? 0 : 50020) + 100);
+        }
+    }
+
+    SUBCASE("Exceptions thrown by the callback reach the caller") {
+        CHECK_THROWS_AS(container.parallelForEach(IterationOrder::Order, [](int value) {
+            if (value == 0) throw std::runtime_error("zero");
+        }), std::runtime_error);
+    }
+}
+
+TEST_CASE("Block traversal") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2, 9, 4}) container.add(v);
+
+    auto blocksOf = [&container](IterationOrder order, size_t blockSize) {
+        std::vector<std::vector<int>> blocks;
+        container.forEachBlock(order, blockSize, [&blocks](std::span<const int> block) {
+            blocks.emplace_back(block.begin(), block.end());
+        });
+        return blocks;
+    };
+
+    CHECK(blocksOf(IterationOrder::Order, 3) == std::vector<std::vector<int>>{{7, 15, 6}, {1, 2, 9}, {4}});
+    CHECK(blocksOf(IterationOrder::Ascending, 4) == std::vector<std::vector<int>>{{1, 2, 4, 6}, {7, 9, 15}});
+    CHECK(blocksOf(IterationOrder::Descending, 7) == std::vector<std::vector<int>>{{15, 9, 7, 6, 4, 2, 1}});
+    CHECK(blocksOf(IterationOrder::SideCross, 2) == std::vector<std::vector<int>>{{1, 15}, {2, 9}, {4, 7}, {6}});
+    CHECK(blocksOf(IterationOrder::Reverse, 5) == std::vector<std::vector<int>>{{4, 9, 2, 1, 6}, {15, 7}});
+    CHECK(blocksOf(IterationOrder::MiddleOut, 10) == std::vector<std::vector<int>>{{1, 6, 2, 15, 9, 7, 4}});
+    CHECK_THROWS_AS(blocksOf(IterationOrder::Order, 0), std::invalid_argument);
+
+    SUBCASE("Forward walks over the storage are zero-copy") {
+        std::vector<const int*> starts;
+        container.forEachBlock(IterationOrder::Order, 4, [&starts](std::span<const int> block) {
+            starts.push_back(block.data());
+        });
+        REQUIRE(starts.size() == 2);
+        CHECK(starts[0] == &*container.beginOrder());
+        CHECK(starts[1] == &container.beginOrder()[4]);
+
+        MyContainer<int, SortedStorage> sorted;
+        for (int v : {5, 3, 8}) sorted.add(v);
+        const int* first = nullptr;
+        sorted.forEachBlock(IterationOrder::Ascending, 8, [&first](std::span<const int> block) {
+            first = block.data();
+        });
+        CHECK(first == &*sorted.beginAscending());
+    }
+}
+
+TEST_CASE("Generator traversals") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2}) container.add(v);
+
+    static_assert(std::ranges::input_range<Generator<int>>);
+    static_assert(std::ranges::view<Generator<int>>);
+
+    auto collect = [](Generator<int> generator) {
+        std::vector<int> out;
+        for (int v : generator) out.push_back(v);
+        return out;
+    };
+
+    CHECK(collect(container.generate(IterationOrder::Ascending)) == std::vector<int>{1, 2, 6, 7, 15});
+    CHECK(collect(container.generate(IterationOrder::Descending, TraversalMode::Lazy)) == std::vector<int>{15, 7, 6, 2, 1});
+    CHECK(collect(container.generate(IterationOrder::SideCross)) == std::vector<int>{1, 15, 2, 7, 6});
+    CHECK(collect(container.generate(IterationOrder::Reverse)) == std::vector<int>{2, 1, 6, 15, 7});
+    CHECK(collect(container.generate(IterationOrder::Order)) == std::vector<int>{7, 15, 6, 1, 2});
+    CHECK(collect(container.generate(IterationOrder::MiddleOut)) == std::vector<int>{6, 15, 1, 7, 2});
+    CHECK(collect(MyContainer<int>().generate(IterationOrder::MiddleOut)).empty());
+
+    SUBCASE("Elements are pulled one at a time") {
+        auto generator = container.generate(IterationOrder::Ascending, TraversalMode::Lazy);
+        auto it = generator.begin();
+        CHECK(*it == 1);
+        ++it;
+        CHECK(*it == 2);
+        CHECK(&*it == &container.beginOrder()[4]);  // Yields references into the container
+
+        std::vector<int> firstTwo;
+        for (int v : container.generate(IterationOrder::Descending) | std::views::take(2)) firstTwo.push_back(v);
+        CHECK(firstTwo == std::vector<int>{15, 7});
+    }
+
+    SUBCASE("A generator can be moved") {
+        Generator<int> generator = container.generate(IterationOrder::Order);
+        Generator<int> moved = std::move(generator);
+        CHECK(collect(std::move(moved)) == std::vector<int>{7, 15, 6, 1, 2});
+    }
+}
+
+TEST_CASE("nthSmallest, median and percentiles") {
+    MyContainer<int> container;
+    std::vector<int> reference;
+    unsigned state = 12345;
+    for (int i = 0; i < 1000; ++i) {
+        state = state * 1103515245u + 12345u;
+        int value = static_cast<int>((state >> 8) % 500);
+        container.add(value);
+        reference.push_back(value);
+    }
+    std::sort(reference.begin(), reference.end());
+
+    bool allMatch = true;
+    for (size_t k = 0; k < reference.size(); k += 37) {
+        allMatch = allMatch && container.nthSmallest(k) == reference[k];
+    }
+    CHECK(allMatch);
+    CHECK(container.nthSmallest(999) == reference.back());
+    CHECK(container.median() == reference[499]);
+    CHECK_THROWS_AS(container.nthSmallest(1000), std::out_of_range);
+
+    // Nearest rank: p90 of 1000 elements is rank 899
+    CHECK(container.percentiles({50, 90, 99, 0, 100, 90}) ==
+          std::vector<int>{reference[499], reference[899], reference[989], reference[0], reference[999], reference[899]});
+    CHECK_THROWS_AS(container.percentiles({101}), std::invalid_argument);
+
+    // p / 100 * n rounds 7 / 100 * 100 up to just above 7, which used to give rank 7
+    MyContainer<int> hundred;
+    for (int v = 1; v <= 100; ++v) hundred.add(v);
+    CHECK(hundred.percentiles({7, 14, 55}) == std::vector<int>{7, 14, 55});
+    CHECK_THROWS_AS(MyContainer<int>().median(), std::out_of_range);
+
+    SUBCASE("Same answers once the sorted view or the index exists") {
+        container.beginAscending();
+        CHECK(container.median() == reference[499]);
+        container.add(-1);
+        container.enableOrderStatistics();
+        CHECK(container.nthSmallest(0) == -1);
+        CHECK(container.percentiles({50}) == std::vector<int>{reference[499]});
+    }
+
+    SUBCASE("Non-arithmetic elements") {
+        MyContainer<std::string> words;
+        for (const char* w : {"pear", "apple", "fig", "kiwi", "banana"}) words.add(w);
+        CHECK(words.median() == "fig");
+        CHECK(words.percentiles({0, 100}) == std::vector<std::string>{"apple", "pear"});
+    }
+}
+
+TEST_CASE("Range queries") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2, 7, 9, 7}) container.add(v);
+    // Ascending: 1 2 6 7 7 7 9 15
+
+    CHECK(*container.lowerBound(7) == 7);
+    CHECK(container.lowerBound(7) - container.beginAscending() == 3);
+    CHECK(container.upperBound(7) - container.beginAscending() == 6);
+    CHECK(*container.upperBound(7) == 9);
+    CHECK(container.lowerBound(16) == container.endAscending());
+    CHECK(container.upperBound(0) == container.beginAscending());
+
+    auto sevens = container.equalRange(7);
+    CHECK(sevens.size() == 3);
+    CHECK(std::all_of(sevens.begin(), sevens.end(), [](int v) { return v == 7; }));
+    CHECK(container.equalRange(8).empty());
+
+    CHECK(container.countInRange(2, 8) == 5);
+    CHECK(container.countInRange(7, 7) == 0);
+    CHECK(container.countInRange(9, 2) == 0);
+    CHECK(container.countInRange(-100, 100) == 8);
+
+    std::vector<int> from(container.ascendingFrom(8).begin(), container.ascendingFrom(8).end());
+    CHECK(from == std::vector<int>{9, 15});
+    std::vector<int> down(container.descendingFrom(6).begin(), container.descendingFrom(6).end());
+    CHECK(down == std::vector<int>{6, 2, 1});
+    CHECK(container.descendingFrom(0).empty());
+
+    SUBCASE("Sorted data, strings and the order-statistic index") {
+        MyContainer<double> sorted;
+        for (double v : {0.5, 1.5, 2.5, 3.5}) sorted.add(v);
+        CHECK(*sorted.lowerBound(2.0) == 2.5);
+        CHECK(sorted.countInRange(1.0, 3.0) == 2);
+
+        MyContainer<std::string> words;
+        for (const char* w : {"pear", "apple", "fig", "kiwi"}) words.add(w);
+        CHECK(*words.upperBound("fig") == "kiwi");
+        CHECK(words.countInRange("b", "l") == 2);
+
+        container.enableOrderStatistics();
+        CHECK(container.countInRange(2, 8) == 5);
+    }
+
+    SUBCASE("Branchless search agrees with std::lower_bound for every size") {
+        MyContainer<int> growing;
+        std::vector<int> reference;
+        bool allMatch = true;
+        for (int size = 0; size < 70; ++size) {
+            std::vector<int> sorted(reference);
+            std::sort(sorted.begin(), sorted.end());
+            for (int value = -1; value <= 36; ++value) {
+                auto expectedLower = std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+                auto expectedUpper = std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+                allMatch = allMatch && growing.lowerBound(value) - growing.beginAscending() == expectedLower
+                                    && growing.upperBound(value) - growing.beginAscending() == expectedUpper;
+            }
+            int next = (size * 17) % 35;
+            growing.add(next);
+            reference.push_back(next);
+        }
+        CHECK(allMatch);
+    }
+}
+
+TEST_CASE("Eytzinger search index") {
+    MyContainer<int> container;
+    container.enableSearchIndex();
+    CHECK(container.hasSearchIndex());
+    CHECK(container.lowerBound(5) == container.endAscending());
+
+    std::vector<int> reference;
+    bool allMatch = true;
+    for (int size = 1; size <= 100; ++size) {
+        int value = (size * 37) % 61;
+        container.add(value);  // Each add makes the index stale; the next query rebuilds it
+        reference.push_back(value);
+        std::vector<int> sorted(reference);
+        std::sort(sorted.begin(), sorted.end());
+        for (int probe = -1; probe <= 61; probe += 3) {
+            auto expectedLower = std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+            auto expectedUpper = std::upper_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+            allMatch = allMatch && container.lowerBound(probe) - container.beginAscending() == expectedLower
+                                && container.upperBound(probe) - container.beginAscending() == expectedUpper;
+        }
+    }
+    CHECK(allMatch);
+
+    container.remove(reference[0]);
+    CHECK(container.equalRange(reference[0]).empty());
+    CHECK(container.countInRange(0, 61) == container.size());
+
+    MyContainer<std::string> words;
+    words.enableSearchIndex();
+    for (const char* w : {"pear", "apple", "fig", "kiwi"}) words.add(w);
+    CHECK(*words.lowerBound("b") == "fig");
+
+    container.disableSearchIndex();
+    CHECK_FALSE(container.hasSearchIndex());
+    CHECK(container.countInRange(0, 61) == container.size());
+}
+
+TEST_CASE("Custom comparator and projection") {
+    MyContainer<std::string> words;
+    for (const char* w : {"pear", "Apple", "fig", "Kiwi", "banana"}) words.add(w);
+
+    auto collect = [](auto&& range) {
+        std::vector<std::string> out(range.begin(), range.end());
+        return out;
+    };
+
+    // Plain operator< puts upper case first; a lower-casing projection does not
+    CHECK(collect(words.ascending()) == std::vector<std::string>{"Apple", "Kiwi", "banana", "fig", "pear"});
+    int projections = 0;
+    auto lowered = [&projections](const std::string& word) {
+        ++projections;
+        std::string key(word);
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return key;
+    };
+    CHECK(collect(words.ascendingBy({}, lowered)) == std::vector<std::string>{"Apple", "banana", "fig", "Kiwi", "pear"});
+    CHECK(projections == 5);  // Once per element, not once per comparison
+
+    auto byLength = [](const std::string& word) { return word.size(); };
+    CHECK(collect(words.descendingBy({}, byLength)).front() == "banana");
+    CHECK(collect(words.sideCrossBy(std::greater<>())) == std::vector<std::string>{"pear", "Apple", "fig", "Kiwi", "banana"});
+
+    SUBCASE("Projection to a struct field") {
+        struct Point {
+            int x;
+            int y;
+            bool operator<(const Point& other) const { return x < other.x; }
+            bool operator==(const Point& other) const { return x == other.x && y == other.y; }
+        };
+        MyContainer<Point> points;
+        for (Point p : {Point{3, 9}, Point{1, 4}, Point{2, 7}}) points.add(p);
+
+        auto byY = points.ascendingBy({}, &Point::y);
+        std::vector<int> ys;
+        for (const Point& p : byY) ys.push_back(p.y);
+        CHECK(ys == std::vector<int>{4, 7, 9});
+        CHECK(byY.size() == 3);
+        CHECK((*(byY.end() - 1) == Point{3, 9}));
+
+        // The cached sorted view still uses operator<
+        CHECK(points.beginAscending()->x == 1);
+    }
+}
+
+// Even positions first, then odd ones: a custom index-mapping policy
+struct EvenThenOdd {
+    static constexpr bool valueOrdered = false;
+    static constexpr bool identity = false;
+
+    static constexpr size_t map(size_t step, size_t size) {
+        size_t evens = (size + 1) / 2;
+        return step < evens ? 2 * step : 2 * (step - evens) + 1;
+    }
+};
+
+// The median first, then outwards in value order: a custom value-ordered policy
+struct MedianOut {
+    static constexpr bool valueOrdered = true;
+    static constexpr bool identity = false;
+
+    static constexpr size_t map(size_t step, size_t size) {
+        return orders::MiddleOut::map(step, size);
+    }
+};
+
+TEST_CASE("Custom iteration-order policies") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2, 9, 4}) container.add(v);
+
+    static_assert(std::random_access_iterator<MyContainer<int>::PolicyIterator<EvenThenOdd>>);
+    static_assert(std::is_same_v<MyContainer<int>::OrderIterator, MyContainer<int>::PolicyIterator<orders::Order>>);
+    static_assert(sizeof(MyContainer<int>::PolicyIterator<EvenThenOdd>) == sizeof(MyContainer<int>::OrderIterator));
+    static_assert(LazyOrderPolicy<orders::SideCross, int> && !LazyOrderPolicy<MedianOut, int>);
+    static_assert(orders::SideCross::map(3, 7) == 5);
+
+    auto collect = [](auto&& range) {
+        std::vector<int> out;
+        for (int v : range) out.push_back(v);
+        return out;
+    };
+
+    CHECK(collect(container.view<EvenThenOdd>()) == std::vector<int>{7, 6, 2, 4, 15, 1, 9});
+    CHECK(collect(container.view<MedianOut>()) == std::vector<int>{6, 4, 7, 2, 9, 1, 15});
+    CHECK(collect(container.generate<MedianOut>()) == std::vector<int>{6, 4, 7, 2, 9, 1, 15});
+    CHECK(collect(container.view<IterationOrder::Descending>(TraversalMode::Lazy)) == std::vector<int>{15, 9, 7, 6, 4, 2, 1});
+    CHECK(container.view<EvenThenOdd>()[5] == 1);
+    CHECK(container.endOf<EvenThenOdd>() - container.beginOf<EvenThenOdd>() == 7);
+
+    SUBCASE("Split, block and parallel paths come with the policy") {
+        auto parts = container.split<EvenThenOdd>(3);
+        REQUIRE(parts.size() == 3);
+        CHECK(collect(parts[0]) == std::vector<int>{7, 6, 2});
+        CHECK(collect(parts[2]) == std::vector<int>{1, 9});
+
+        std::vector<std::vector<int>> blocks;
+        container.forEachBlock<MedianOut>(3, [&blocks](std::span<const int> block) {
+            blocks.emplace_back(block.begin(), block.end());
+        });
+        CHECK(blocks == std::vector<std::vector<int>>{{6, 4, 7}, {2, 9, 1}, {15}});
+        CHECK_THROWS_AS(container.forEachBlock<EvenThenOdd>(0, [](std::span<const int>) {}), std::invalid_argument);
+
+        MyContainer<int> large;
+        for (int i = 0; i < 100'000; ++i) large.add(i % 97);
+        std::atomic<long long> sum = 0;
+        large.parallelForEach<EvenThenOdd>([&sum](int v) { sum += v; });
+        CHECK(sum == std::accumulate(large.beginOrder(), large.endOrder(), 0LL));
+    }
+}